@@ -0,0 +1,42 @@
+#include "Arduino.h"
+#include <FourWireFanArray.h>  // https://github.com/sekdiy/FourWireFan
+
+// set the measurement update period to 1s (1000 ms)
+const unsigned long period = 1000;
+
+// up to three fans, no hand written interrupt service routines required
+FourWireFanArray<3> Fans;
+
+void setup() {
+    // prepare serial communication
+    Serial.begin(115200);
+
+    // connect the fans (PWM pin, tach pin) with a fan model each (see notes on your Arduino model for pin numbers)
+    Fans.add<5, 2>(&NF_A12_25_FanModel)->setPWM(30);
+    Fans.add<6, 3>()->setPWM(50);
+    Fans.add<9, 7>()->setPWM(70);
+
+    // sometimes initializing the gear generates some initial pulses that we want to ignore
+    Fans.reset();
+}
+
+void loop() {
+    // wait between output updates
+    delay(period);
+
+    // process the (possibly) counted ticks of all fans at once
+    Fans.update(period);
+
+    // output some measurement results
+    for (uint8_t i = 0; i < Fans.size(); i++) {
+        Serial.print("Fan ");
+        Serial.print(i);
+        Serial.print(": ");
+        Serial.print(Fans[i]->getRPM());
+        Serial.println(" 1/min");
+    }
+
+    //
+    // any other code can go here
+    //
+}
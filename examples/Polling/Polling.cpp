@@ -0,0 +1,42 @@
+#include "Arduino.h"
+#include <FourWireFan.h>  // https://github.com/sekdiy/FourWireFan
+
+// set the (minimum) measurement update period to 1s (1000 ms)
+const unsigned long period = 1000;
+
+// connect a fan to an analog and an interrupt pin (see notes on your Arduino model for pin numbers)
+FourWireFan Fan;
+
+// define an 'interrupt service handler' (ISR) to help count the tach pulses
+void tachISR() {
+    // let our Fan instance handle the actual pulse counting
+    Fan.count();
+}
+
+void setup() {
+    // prepare serial communication
+    Serial.begin(115200);
+
+    // connect the fan to pins 3 (PWM) and 2 (tach)
+    Fan = FourWireFan(3, 2, tachISR);
+    Fan.setPWM(50);
+
+    // sometimes initializing the gear generates some initial pulses that we want to ignore
+    Fan.reset();
+}
+
+void loop() {
+    // process the counted ticks once a period has passed (returns immediately otherwise)
+    if (Fan.poll(period)) {
+        // output some measurement results
+        Serial.print("Currently ");
+        Serial.print(Fan.getRPM());
+        Serial.print(" 1/min (measured over ");
+        Serial.print(Fan.getElapsed() / 1000);
+        Serial.println(" ms)");
+    }
+
+    //
+    // any other code can go here, no need to wait
+    //
+}
@@ -0,0 +1,129 @@
+/**
+ * Profiles the hot path and sweeps fan count and tach edge rate, i.e. how many fans (at what speed) one microcontroller can handle.
+ *
+ * The probes are compiled in by `FOURWIREFAN_PROFILE`, see the `profile` environment for the hardware
+ * (`pio run -e profile -t upload -t monitor`) and the `native_profile` environment for the simulated core
+ * (`pio run -e native_profile -t exec`, which measures host time, not AVR cycles, and sees the host's preemption in the maxima).
+ *
+ * The tach edges are fired in software, so no fans need to be connected (but the PWM pins are driven, so use a bare board).
+ */
+
+#include "Arduino.h"
+#include <FourWireFanArray.h>  // https://github.com/sekdiy/FourWireFan
+
+// what the figures apply to (the simulated core measures host time, so its limits say nothing about an AVR)
+#if defined(__AVR__)
+const char* target = "";
+#else
+const char* target = " (host figures, not the AVR's)";
+#endif
+
+// the update rate of the sweep (in Hz, i.e. updates every 100 ms)
+const uint32_t rate = 10;
+
+// the tach edge rates of the sweep (per fan, in edges per second)
+const uint32_t edgeRates[] = {100, 1000, 5000, 10000, 20000};
+
+// interrupt entry, exit and dispatch, which the probes can't see (in ns)
+#if defined(__AVR__)
+const uint32_t dispatch = 80 * (1000000000UL / F_CPU);   // about 80 cycles
+#else
+const uint32_t dispatch = 0;
+#endif
+
+// every edge counts (no debouncing), and measuring by period is the more expensive evaluation
+FourWireFanSettings Settings(3, 2, nullptr, FALLING, INPUT_PULLUP, 0L, FOURWIREFAN_PERIOD);
+
+FourWireFanArray<1> One;
+FourWireFanArray<2> Two;
+FourWireFanArray<4> Four;
+FourWireFanArray<8> Eight;
+
+// connects up to eight fans (an array just ignores any beyond its size)
+template <uint8_t N>
+void connect(FourWireFanArray<N>& fans) {
+    fans.template add<5, 2>(&NF_A12_25_FanModel, Settings);
+    fans.template add<6, 3>(&NF_A12_25_FanModel, Settings);
+    fans.template add<9, 7>(&NF_A12_25_FanModel, Settings);
+    fans.template add<10, 0>(&NF_A12_25_FanModel, Settings);
+    fans.template add<14, 1>(&NF_A12_25_FanModel, Settings);
+    fans.template add<15, 4>(&NF_A12_25_FanModel, Settings);
+    fans.template add<16, 8>(&NF_A12_25_FanModel, Settings);
+    fans.template add<18, 19>(&NF_A12_25_FanModel, Settings);
+}
+
+// the CPU load of the library (in 1/1000 %) at an edge rate (per fan)
+uint32_t load(uint8_t fans, uint32_t edgeRate) {
+    uint64_t busy = (uint64_t) fans * edgeRate * (FourWireFanProfile::getMean(FOURWIREFAN_PROBE_COUNT) + dispatch)
+        + (uint64_t) rate * FourWireFanProfile::getMean(FOURWIREFAN_PROBE_UPDATE)
+        + (uint64_t) rate * fans * FourWireFanProfile::getMean(FOURWIREFAN_PROBE_SETPWM); // (in ns per second)
+
+    return busy / 10000UL;
+}
+
+// profiles an array of fans, then reports the CPU load for each edge rate and the throughput limits
+template <uint8_t N>
+void sweep(FourWireFanArray<N>& fans) {
+    connect(fans);
+
+    for (uint8_t i = 0; i < fans.size(); i++) {
+        fans[i]->begin();
+    }
+
+    FourWireFanProfile::reset();
+
+    for (uint8_t k = 0; k < 100; k++) {
+        for (uint8_t e = 0; e < 32; e++) {
+            for (uint8_t i = 0; i < fans.size(); i++) {
+                fans[i]->count();                   // (as called by its ISR)
+            }
+            delayMicroseconds(50);
+        }
+
+        fans.update(FOURWIREFAN_ELAPSED);
+
+        for (uint8_t i = 0; i < fans.size(); i++) {
+            fans[i]->setPWM(30 + (k + i) % 50);
+        }
+    }
+
+    uint32_t count = max(FourWireFanProfile::getMean(FOURWIREFAN_PROBE_COUNT) + dispatch, 1UL);
+    uint32_t latency = FourWireFanProfile::getLatency(fans.size()) + dispatch;
+
+    Serial.println(String(fans.size()) + " fan(s): count() " + String(FourWireFanProfile::getMean(FOURWIREFAN_PROBE_COUNT))
+        + " ns (max " + String(FourWireFanProfile::getMax(FOURWIREFAN_PROBE_COUNT)) + "), update() "
+        + String(FourWireFanProfile::getMean(FOURWIREFAN_PROBE_UPDATE)) + " ns (max " + String(FourWireFanProfile::getMax(FOURWIREFAN_PROBE_UPDATE))
+        + "), setPWM() " + String(FourWireFanProfile::getMean(FOURWIREFAN_PROBE_SETPWM)) + " ns, interrupts held off for up to "
+        + String(FourWireFanProfile::getMax(FOURWIREFAN_PROBE_CRITICAL)) + " ns");
+
+    Serial.print("  CPU load at");
+    for (uint8_t r = 0; r < sizeof(edgeRates) / sizeof(edgeRates[0]); r++) {
+        uint32_t share = load(fans.size(), edgeRates[r]);
+        Serial.print(" " + String(edgeRates[r]) + "/s: " + String(share / 1000) + "." + String(share / 100 % 10) + String(share / 10 % 10) + String(share % 10) + "%");
+    }
+    Serial.println();
+
+    uint32_t budget = 1000000000UL - min(load(fans.size(), 0) * 10000UL, 1000000000UL); // what's left for the ISRs (in ns per second)
+    uint32_t busy = budget / ((uint32_t) fans.size() * count);     // edges per second and fan until the CPU is saturated
+    uint32_t pending = 1000000000UL / (latency + count);            // edges per second and fan until an edge arrives while its previous one is still pending
+
+    uint32_t limit = min(busy, pending);
+
+    Serial.println("  limit" + String(target) + ": " + String(limit) + " edges/s per fan (" + String(limit * 3 / 100) + "k rpm at 2 ppr), by "
+        + ((busy < pending) ? String("CPU load") : String("interrupt latency of up to ") + String(latency) + " ns"));
+}
+
+void setup() {
+    Serial.begin(115200);
+
+    Serial.println("Cost of the hot path and throughput limits (updates at " + String(rate) + " Hz, every edge counted)" + String(target) + ":");
+
+    sweep(One);
+    sweep(Two);
+    sweep(Four);
+    sweep(Eight);
+}
+
+void loop() {
+    // all measurements run from setup()
+}
@@ -0,0 +1,33 @@
+#include "Arduino.h"
+#include <FourWireFanT.h>  // https://github.com/sekdiy/FourWireFan
+
+// set the measurement update period to 1s (1000 ms)
+const unsigned long period = 1000;
+
+// connect a Noctua NF-A12x25 to pins 3 (PWM) and 2 (tach), all fixed at compile time (no ISR to write, no heap, model in flash)
+FourWireFanT<3, 2, NF_A12_25_ConstModel> Fan;
+
+void setup() {
+    // prepare serial communication
+    Serial.begin(115200);
+
+    // connect the fan (and clear any initial pulses)
+    Fan.begin();
+
+    // run the fan at about 1000 rpm
+    Fan.setRPM(1000);
+}
+
+void loop() {
+    // process the counted ticks once a period has passed (returns immediately otherwise)
+    if (Fan.poll(period)) {
+        // output some measurement results
+        Serial.print("Currently ");
+        Serial.print(Fan.getRPM());
+        Serial.println(" 1/min");
+    }
+
+    //
+    // any other code can go here, no need to wait
+    //
+}
@@ -0,0 +1,76 @@
+/**
+ * Four Wire Fan
+ *
+ * A simulated Arduino core for building and running the library natively (i.e. without hardware).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 16.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <stdio.h>
+#include "Arduino.h"
+
+int simulationRead(bool peek);
+int simulationAvailable();
+
+HardwareSerial Serial;
+
+/* time (wraps around like on the real thing) */
+unsigned long millis() { return (uint32_t) (Simulation::now / 1000); }
+unsigned long micros() { return (uint32_t) Simulation::now; }
+void delay(unsigned long ms) { Simulation::advance((uint64_t) ms * 1000); }
+void delayMicroseconds(unsigned int us) { Simulation::advance(us); }
+
+/* digital and analog i/o */
+void pinMode(uint8_t pin, uint8_t mode) { (void) pin; (void) mode; }
+void digitalWrite(uint8_t pin, uint8_t val) { Simulation::setAnalog(pin, val ? 255 : 0); }
+int digitalRead(uint8_t pin) { return Simulation::level(pin); }
+void analogWrite(uint8_t pin, int val) { Simulation::setAnalog(pin, constrain(val, 0, 255)); }
+int analogRead(uint8_t pin) { (void) pin; return 0; }
+
+/* interrupts */
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode) { Simulation::setInterrupt(interruptNum, userFunc, mode); }
+void detachInterrupt(uint8_t interruptNum) { Simulation::setInterrupt(interruptNum, nullptr, 0); }
+void noInterrupts() { Simulation::setInterrupts(false); }
+void interrupts() { Simulation::setInterrupts(true); }
+
+/* strings */
+String::String(double value, unsigned char decimals)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+    this->_str = buffer;
+}
+
+/* serial port */
+int HardwareSerial::available() { return simulationAvailable(); }
+int HardwareSerial::read() { return simulationRead(false); }
+int HardwareSerial::availableForWrite() { return 63; }
+void HardwareSerial::flush() { fflush(stdout); }
+size_t HardwareSerial::write(uint8_t c) { return fwrite(&c, 1, 1, stdout); }
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) { return fwrite(buffer, 1, size, stdout); }
+size_t HardwareSerial::print(const String& s) { return this->print(s.c_str()); }
+size_t HardwareSerial::print(const char* s) { return fputs(s, stdout) < 0 ? 0 : strlen(s); }
+size_t HardwareSerial::print(long n) { return printf("%ld", n); }
+size_t HardwareSerial::print(unsigned long n) { return printf("%lu", n); }
+size_t HardwareSerial::print(double n, int digits) { return printf("%.*f", digits, n); }
+
+/**
+ * Runs the sketch until it stops itself or runs out of (simulated) time.
+ */
+int main()
+{
+    srand(1);                                       // reproducible jitter
+
+    setup();
+
+    while (!Simulation::stopped()) {
+        loop();
+        Simulation::advance(Simulation::loopTime);
+    }
+
+    fflush(stdout);
+
+    return Simulation::status();
+}
@@ -0,0 +1,163 @@
+/**
+ * Four Wire Fan
+ *
+ * A simulated Arduino core for building and running the library natively (i.e. without hardware).
+ *
+ * Only the subset of the Arduino API used by the library and its examples is provided.
+ * Time is simulated: it only advances via `delay()`, `delayMicroseconds()` or between two calls to `loop()`.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 16.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include "avr/io.h"
+#include "avr/pgmspace.h"
+
+#define FOURWIREFAN_NATIVE 1                       // building against the simulated Arduino core
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define PI 3.1415926535897932384626433832795
+
+#define NOT_AN_INTERRUPT -1
+#define digitalPinToInterrupt(p) (p)               // the simulation maps every pin to an interrupt of the same number
+
+#ifndef min
+#define min(a,b) ((a)<(b)?(a):(b))
+#endif
+#ifndef max
+#define max(a,b) ((a)>(b)?(a):(b))
+#endif
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define sq(x) ((x)*(x))
+
+/* time */
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+/* digital and analog i/o */
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+int analogRead(uint8_t pin);
+
+/* interrupts */
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode);
+void detachInterrupt(uint8_t interruptNum);
+void noInterrupts();
+void interrupts();
+
+/* sketch */
+void setup();
+void loop();
+
+/**
+ * A minimal stand-in for the Arduino `String` class.
+ */
+class String {
+    public:
+        String(const char* str = "") : _str(str ? str : "") { /* nop */ }
+        String(const std::string& str) : _str(str) { /* nop */ }
+        String(char c) : _str(1, c) { /* nop */ }
+        String(int value) : _str(std::to_string(value)) { /* nop */ }
+        String(unsigned int value) : _str(std::to_string(value)) { /* nop */ }
+        String(long value) : _str(std::to_string(value)) { /* nop */ }
+        String(unsigned long value) : _str(std::to_string(value)) { /* nop */ }
+        String(double value, unsigned char decimals = 2);
+
+        const char* c_str() const { return this->_str.c_str(); }
+        unsigned int length() const { return this->_str.length(); }
+
+        String& operator+=(const String& rhs) { this->_str += rhs._str; return *this; }
+        friend String operator+(const String& lhs, const String& rhs) { return String(lhs._str + rhs._str); }
+
+    protected:
+        std::string _str;
+};
+
+/**
+ * A minimal stand-in for the Arduino `Stream` class (i.e. the byte level interface of `Print` and `Stream`).
+ */
+class Stream {
+    public:
+        virtual ~Stream() {}
+
+        virtual int available() = 0;
+        virtual int read() = 0;
+        virtual int availableForWrite() { return 0; }
+
+        virtual size_t write(uint8_t c) = 0;
+        virtual size_t write(const uint8_t* buffer, size_t size) {
+            size_t n = 0;
+            while ((n < size) && this->write(buffer[n])) {
+                n++;
+            }
+            return n;
+        }
+};
+
+/**
+ * A minimal stand-in for the Arduino serial port (writes to stdout, reads from an injectable input buffer).
+ */
+class HardwareSerial : public Stream {
+    public:
+        void begin(unsigned long baud) { (void) baud; }
+        void end() { /* nop */ }
+        operator bool() { return true; }
+
+        int available() override;
+        int read() override;
+        int availableForWrite() override;
+        void flush();
+
+        size_t write(uint8_t c) override;
+        size_t write(const uint8_t* buffer, size_t size) override;
+
+        size_t print(const String& s);
+        size_t print(const char* s);
+        size_t print(long n);
+        size_t print(unsigned long n);
+        size_t print(int n) { return this->print((long) n); }
+        size_t print(unsigned int n) { return this->print((unsigned long) n); }
+        size_t print(double n, int digits = 2);
+
+        size_t println() { return this->print("\n"); }
+        template <typename T> size_t println(T value) { return this->print(value) + this->println(); }
+        size_t println(double n, int digits) { return this->print(n, digits) + this->println(); }
+};
+
+extern HardwareSerial Serial;
+
+#include "Simulation.h"
+
+#ifndef FOURWIREFAN_PROFILE_CLOCK
+#define FOURWIREFAN_PROFILE_CLOCK() Simulation::ticks() // profile by the host's clock (simulated time stands still while code runs)
+#define FOURWIREFAN_PROFILE_TICKS 1000             // ticks per µs (i.e. ns)
+#endif
+
+#endif  // Arduino_h
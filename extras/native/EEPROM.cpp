@@ -0,0 +1,114 @@
+/**
+ * Four Wire Fan
+ *
+ * A simulated EEPROM, backed by a file (so it survives a restart of the simulation, like the real one survives a reset).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 16.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <stdio.h>
+#include "EEPROM.h"
+
+EEPROMClass EEPROM;
+
+/**
+ * Returns the byte at an address (outside the EEPROM: 0xFF).
+ *
+ * @since 2026-10-16
+ *
+ * @param idx The address
+ *
+ * @return uint8_t
+ */
+uint8_t EEPROMClass::read(int idx)
+{
+    this->load();
+
+    return ((0 <= idx) && (idx <= E2END)) ? this->_data[idx] : 0xFF;
+}
+
+/**
+ * Writes a byte, straight through to the backing file (outside the EEPROM: ignored).
+ *
+ * @since 2026-10-16
+ *
+ * @param idx The address
+ * @param val The byte
+ */
+void EEPROMClass::write(int idx, uint8_t val)
+{
+    this->load();
+
+    if ((idx < 0) || (idx > E2END)) {
+        return;
+    }
+
+    this->_data[idx] = val;
+    this->_writes++;
+
+    FILE* file = fopen(this->_path, "r+b");
+
+    if (!file) {
+        file = fopen(this->_path, "w+b");
+    }
+
+    if (file) {
+        fwrite(this->_data, 1, sizeof(this->_data), file);
+        fclose(file);
+    }
+}
+
+/**
+ * Writes a byte only if it differs from the stored one (like the real `EEPROM.update()`).
+ *
+ * @since 2026-10-16
+ *
+ * @param idx The address
+ * @param val The byte
+ */
+void EEPROMClass::update(int idx, uint8_t val)
+{
+    if (this->read(idx) != val) {
+        this->write(idx, val);
+    }
+}
+
+/**
+ * Switches to a backing file and (re)reads it, i.e. simulates a reset or another device.
+ *
+ * @since 2026-10-16
+ *
+ * @param path The backing file
+ */
+void EEPROMClass::attach(const char* path)
+{
+    this->_path = path;
+    this->_loaded = false;
+    this->_writes = 0;
+}
+
+/**
+ * Reads the backing file, unless done already (missing bytes read as erased, i.e. 0xFF).
+ *
+ * @since 2026-10-16
+ */
+void EEPROMClass::load()
+{
+    if (this->_loaded) {
+        return;
+    }
+
+    memset(this->_data, 0xFF, sizeof(this->_data));
+
+    FILE* file = fopen(this->_path, "rb");
+
+    if (file) {
+        size_t size = fread(this->_data, 1, sizeof(this->_data), file);
+        (void) size;                                // (a short file leaves the rest erased)
+        fclose(file);
+    }
+
+    this->_loaded = true;
+}
@@ -0,0 +1,48 @@
+/**
+ * Four Wire Fan
+ *
+ * A simulated EEPROM, backed by a file (so it survives a restart of the simulation, like the real one survives a reset).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 16.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef EEPROM_h
+#define EEPROM_h
+
+#include "Arduino.h"
+
+#ifndef EEPROM_FILE
+#define EEPROM_FILE "eeprom.bin"                   // the default backing file (in the working directory)
+#endif
+
+/**
+ * A minimal stand-in for the Arduino `EEPROM` library (byte access only).
+ *
+ * The contents are read from the backing file on first access (missing bytes read as erased, i.e. 0xFF),
+ * and every write goes straight through to it. Writes are counted, so wear can be checked.
+ */
+class EEPROMClass {
+    public:
+        uint8_t read(int idx);                      // Returns the byte at an address
+        void write(int idx, uint8_t val);           // Writes a byte (always)
+        void update(int idx, uint8_t val);          // Writes a byte only if it differs (i.e. sparing the cell)
+        uint16_t length() { return E2END + 1; }     // Returns the EEPROM size (in bytes)
+
+        /* simulation only: */
+        void attach(const char* path);              // Switches to (or rereads) a backing file, i.e. a reset
+        uint32_t getWrites() { return this->_writes; } // Returns the number of bytes written so far
+
+    protected:
+        uint8_t _data[E2END + 1];                   // the contents
+        const char* _path = EEPROM_FILE;            // the backing file
+        bool _loaded = false;                       // contents read from the backing file?
+        uint32_t _writes = 0;                       // the number of bytes written
+
+        void load();                                // reads the backing file (if not done yet)
+};
+
+extern EEPROMClass EEPROM;
+
+#endif  // EEPROM_h
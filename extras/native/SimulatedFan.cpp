@@ -0,0 +1,190 @@
+/**
+ * Four Wire Fan
+ *
+ * A simulated four wire fan (plant model) for running the library natively (i.e. without hardware).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 16.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "SimulatedFan.h"
+
+/**
+ * Constructs (and connects) a new simulated fan.
+ *
+ * @since 2026-10-16
+ *
+ * @param pwmPin The input pin connected to the fan's PWM output
+ * @param tachPin The output pin connected to the fan's tach input
+ * @param maxRPM The speed at 100% duty
+ * @param inertia The rotor time constant (in ms)
+ */
+SimulatedFan::SimulatedFan(uint8_t pwmPin, uint8_t tachPin, uint16_t maxRPM, uint16_t inertia) :
+    pwmPin(pwmPin),
+    tachPin(tachPin),
+    minRPM(400),
+    maxRPM(maxRPM),
+    stallPWM(15),
+    startPWM(30),
+    inertia(inertia),
+    ppr(2),
+    wires(4),
+    jitter(0),
+    bounce(0),
+    bounceTime(200),
+    noise(0),
+    blocked(false),
+    disconnected(false),
+    refRPM(nullptr)
+{
+    Simulation::attach(this);
+}
+
+/**
+ * Advances the rotor by one step and schedules the resulting tach edges.
+ *
+ * @since 2026-10-16
+ *
+ * @param now The beginning of the step (in µs)
+ * @param step The length of the step (in µs)
+ */
+void SimulatedFan::run(uint64_t now, uint32_t step)
+{
+    float target = this->getTarget();
+
+    /* first order inertia (a blocked rotor stops immediately) */
+    if (this->blocked) {
+        this->_rpm = 0.0f;
+    } else {
+        this->_rpm += (target - this->_rpm) * (1.0f - expf(-(float) step / (1000.0f * max(this->inertia, (uint16_t) 1))));
+    }
+
+    /* glitches during this step (at random) */
+    if (this->noise && ((double) rand() / RAND_MAX < (double) this->noise * step / 1000000.0)) {
+        uint64_t at = now + (uint64_t) rand() % step;
+        Simulation::edge(this->tachPin, LOW, at);
+        Simulation::edge(this->tachPin, HIGH, at + 2);
+    }
+
+    /* tach pulses (i.e. phase wraps) during this step */
+    double rate = (double) this->_rpm * this->ppr / 60.0 / 1000000.0; // pulses per µs
+    double increment = rate * step;
+
+    this->_phase += increment;
+
+    while (this->_phase >= 1.0) {
+        double period = 1.0 / rate;
+        double at = now + step * (1.0 - (this->_phase - 1.0) / increment);
+        double offset = this->jitter * period / 100.0 * (2.0 * rand() / RAND_MAX - 1.0);
+
+        this->_phase -= 1.0;
+        this->_pulses++;
+
+        if (this->disconnected) {
+            continue;                                                       // the pull-up keeps the tach pin high
+        }
+
+        uint64_t low = (uint64_t) max(at + offset, (double) now);
+        uint64_t high = low + (uint64_t) (period / 2.0);
+        float duty = this->getDuty();
+
+        if ((3 == this->wires) && (duty < 100.0f)) {                        // the tach output is only powered during the PWM on phase…
+            uint64_t on = (uint64_t) (SIMULATEDFAN_PWM_CYCLE * duty / 100.0f);
+            for (uint64_t t = low - low % SIMULATEDFAN_PWM_CYCLE; on && (t < high); t += SIMULATEDFAN_PWM_CYCLE) {
+                uint64_t from = max(t, low), to = min(t + on, high);
+                if (from < to) {
+                    Simulation::edge(this->tachPin, LOW, from);             // …so it pulls low in bursts (the pull-up wins in between)
+                    Simulation::edge(this->tachPin, HIGH, to);
+                }
+            }
+            continue;
+        }
+
+        Simulation::edge(this->tachPin, LOW, low);                          // tach pulse (open collector pulls low)…
+
+        for (uint8_t i = 1; i <= this->bounce; i++) {                       // …bouncing…
+            uint64_t t = low + (uint64_t) this->bounceTime * i / (this->bounce + 1);
+            Simulation::edge(this->tachPin, HIGH, t);
+            Simulation::edge(this->tachPin, LOW, t + this->bounceTime / (2 * (this->bounce + 1)) + 1);
+        }
+
+        Simulation::edge(this->tachPin, HIGH, high);                        // …and release after half a pulse period
+    }
+}
+
+/**
+ * Returns the applied duty cycle (in %).
+ *
+ * @since 2026-10-16
+ *
+ * @return float
+ */
+float SimulatedFan::getDuty()
+{
+    return Simulation::duty(this->pwmPin);
+}
+
+/**
+ * Returns the steady state speed for the applied duty cycle.
+ *
+ * @since 2026-10-16
+ *
+ * @return float
+ */
+float SimulatedFan::getTarget()
+{
+    float duty = this->getDuty();
+
+    if (this->blocked || (duty < this->stallPWM) || ((this->_rpm < this->minRPM / 4) && (duty < this->startPWM))) {
+        return 0.0f;                                // stalled or not able to break away
+    }
+
+    if (this->refRPM) {                             // interpolate the reference curve (10%, 20%, … 100%)
+        float index = constrain(duty / 10.0f - 1.0f, 0.0f, 9.0f);
+        uint8_t i = min((uint8_t) index, (uint8_t) 8);
+        return this->refRPM[i] + (index - i) * (this->refRPM[i + 1] - this->refRPM[i]);
+    }
+
+    return this->minRPM + (this->maxRPM - this->minRPM) * (duty - this->stallPWM) / (100.0f - this->stallPWM);
+}
+
+/**
+ * Returns the actual speed (i.e. the ground truth).
+ *
+ * @since 2026-10-16
+ *
+ * @return float
+ */
+float SimulatedFan::getRPM()
+{
+    return this->_rpm;
+}
+
+/**
+ * Returns the number of (bounce free) tach pulses so far.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint32_t
+ */
+uint32_t SimulatedFan::getPulses()
+{
+    return this->_pulses;
+}
+
+/**
+ * Forces the actual speed (e.g. to start from a running rotor).
+ *
+ * @since 2026-10-16
+ *
+ * @param rpm The actual speed to set
+ *
+ * @return SimulatedFan*
+ */
+SimulatedFan* SimulatedFan::setRPM(float rpm)
+{
+    this->_rpm = rpm;
+
+    return this;
+}
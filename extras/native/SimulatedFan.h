@@ -0,0 +1,71 @@
+/**
+ * Four Wire Fan
+ *
+ * A simulated four wire fan (plant model) for running the library natively (i.e. without hardware).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 16.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef __SIMULATEDFAN_H__
+#define __SIMULATEDFAN_H__
+
+#include "Arduino.h"
+
+#define SIMULATEDFAN_PWM_CYCLE 2040                // the PWM period chopping a three wire fan's tach output (in µs, i.e. `analogWrite()`)
+
+/**
+ * A simulated four wire fan that turns PWM duty into tach edges.
+ *
+ * The rotor follows the duty cycle with first order inertia. It stalls below `stallPWM` and needs `startPWM` to break away.
+ * Each tach pulse pulls the tach pin low for half a pulse period, optionally with jitter and contact bounce.
+ * A broken tach wire suppresses the tach pulses (the rotor keeps running).
+ * A three wire fan's tach output is powered by the PWM'd supply, so its pulses are chopped by the PWM (at about 490 Hz) below 100% duty.
+ * Additionally, short glitches (2 µs low) may appear on the tach line at random moments.
+ */
+class SimulatedFan {
+    public:
+        // public properties to avoid the getter/setter pattern
+        uint8_t pwmPin;        // The input pin connected to the fan's PWM output
+        uint8_t tachPin;       // The output pin connected to the fan's tach input
+        uint16_t minRPM;       // speed at `stallPWM` (default: 400 rpm)
+        uint16_t maxRPM;       // speed at 100% duty (default: 2000 rpm)
+        uint8_t stallPWM;      // duty below which the running rotor stops (default: 15%)
+        uint8_t startPWM;      // duty required for a standing rotor to break away (default: 30%)
+        uint16_t inertia;      // rotor time constant (default: 500 ms)
+        uint8_t ppr;           // tach pulses per revolution (default: 2)
+        uint8_t wires;         // three wire fan (tach pulses chopped by the PWM) or four wire fan (default: 4)
+        uint8_t jitter;        // random tach edge displacement (in % of the pulse period, default: 0)
+        uint8_t bounce;        // additional bounce edges per tach edge (default: 0)
+        uint16_t bounceTime;   // duration of the bouncing (in µs, default: 200)
+        uint16_t noise;        // random glitches on the tach line, e.g. coupled in from PWM (per second, default: 0)
+        bool blocked;          // rotor blocked (e.g. by a finger)?
+        bool disconnected;     // tach wire broken (the rotor keeps running, but there are no more tach edges)?
+        const uint16_t* refRPM; // speed reference values at 10%, 20%, … 100% duty (default: none, i.e. linear)
+
+        /**
+         * Constructs (and connects) a new simulated fan.
+         *
+         * @param pwmPin       The input pin connected to the fan's PWM output (default: 3)
+         * @param tachPin      The output pin connected to the fan's tach input (default: 2)
+         * @param maxRPM       The speed at 100% duty (default: 2000 rpm)
+         * @param inertia      The rotor time constant (default: 500 ms)
+         */
+        SimulatedFan(uint8_t pwmPin = 3, uint8_t tachPin = 2, uint16_t maxRPM = 2000, uint16_t inertia = 500);
+
+        void run(uint64_t now, uint32_t step);     // advances the rotor by one step and schedules the resulting tach edges
+
+        float getDuty();                            // Returns the applied duty cycle (in %)
+        float getTarget();                          // Returns the steady state speed for the applied duty cycle
+        float getRPM();                             // Returns the actual speed (i.e. the ground truth)
+        uint32_t getPulses();                       // Returns the number of (bounce free) tach pulses so far
+        SimulatedFan* setRPM(float rpm);            // Forces the actual speed (e.g. to start from a running rotor)
+
+    protected:
+        float _rpm = 0.0f;                          // the actual speed
+        double _phase = 0.0;                        // the progress towards the next tach pulse (in pulses)
+        uint32_t _pulses = 0;                       // the number of tach pulses so far
+};
+
+#endif  // __SIMULATEDFAN_H__
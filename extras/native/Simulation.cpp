@@ -0,0 +1,316 @@
+/**
+ * Four Wire Fan
+ *
+ * A simulated Arduino core for building and running the library natively (i.e. without hardware).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 16.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <map>
+#include <vector>
+#include <deque>
+#include <chrono>
+#include "Arduino.h"
+#include "SimulatedFan.h"
+
+uint64_t Simulation::now = 0;
+uint32_t Simulation::step = 50;
+uint32_t Simulation::loopTime = 10;
+uint64_t Simulation::runtime = 60000000ULL;
+uint32_t Simulation::critical = 0;
+
+/* simulated registers */
+volatile uint8_t TCCR1A = 0;
+volatile uint8_t TCCR1B = 0;
+volatile uint16_t TCNT1 = 0;
+volatile uint16_t ICR1 = 0;
+volatile uint16_t OCR1A = 0;
+volatile uint16_t OCR1B = 0;
+volatile uint16_t OCR1C = 0;
+volatile uint8_t TCCR3A = 0;
+volatile uint8_t TCCR3B = 0;
+volatile uint16_t ICR3 = 0;
+volatile uint16_t OCR3A = 0;
+
+/**
+ * The internal state of the simulated microcontroller.
+ */
+namespace {
+    struct Interrupt {
+        void (*isr)(void) = nullptr;                // attached interrupt service routine
+        int mode = 0;                               // interrupt mode (CHANGE, FALLING, RISING)
+        bool pending = false;                       // edge arrived while interrupts were disabled
+    };
+
+    struct State {
+        std::vector<SimulatedFan*> fans;            // connected simulated fans
+        std::multimap<uint64_t, std::pair<uint8_t, uint8_t> > edges; // scheduled pin level changes (pin, level)
+        Interrupt interrupt[SIMULATION_PINS];       // attached interrupts (one per pin)
+        uint8_t level[SIMULATION_PINS];             // current pin levels
+        uint8_t analog[SIMULATION_PINS];            // latest `analogWrite()` values
+        std::deque<uint8_t> input;                  // received serial data
+        uint64_t plant = 0;                         // the moment the plant models have been run up to
+        bool enabled = true;                        // interrupts enabled?
+        bool isr = false;                           // currently running an interrupt service routine?
+        bool stopped = false;                       // sketch stopped?
+        int status = 0;                             // exit status
+
+        State() {
+            memset(this->level, HIGH, sizeof(this->level));  // (pulled up) inputs
+            memset(this->analog, 0, sizeof(this->analog));
+        }
+    };
+
+    State& state()
+    {
+        static State instance;                      // constructed on first use (i.e. safe during static initialisation)
+        return instance;
+    }
+}
+
+/**
+ * Advances the simulated time, running the plant(s) and delivering interrupts.
+ *
+ * @since 2026-10-16
+ *
+ * @param us The time to advance (in µs)
+ */
+void Simulation::advance(uint64_t us)
+{
+    State& s = state();
+    uint64_t end = Simulation::now + us;
+
+    while (true) {
+        /* run the plant models ahead of time, so that their edges are scheduled in time */
+        while (s.plant <= end) {
+            for (SimulatedFan* fan : s.fans) {
+                fan->run(s.plant, Simulation::step);
+            }
+            s.plant += Simulation::step;
+        }
+
+        /* deliver the next edge up to the end of this advance */
+        auto next = s.edges.begin();
+        if ((next == s.edges.end()) || (next->first > end)) {
+            break;
+        }
+
+        uint8_t pin = next->second.first;
+        uint8_t level = next->second.second;
+        Simulation::now = max(Simulation::now, next->first);
+        s.edges.erase(next);
+
+        if ((pin < SIMULATION_PINS) && (s.level[pin] != level)) {
+            s.level[pin] = level;
+
+            uint8_t clock = TCCR1B & (_BV(CS12) | _BV(CS11) | _BV(CS10));
+            if ((SIMULATION_T1_PIN == pin) && (((6 == clock) && (LOW == level)) || ((7 == clock) && (HIGH == level)))) {
+                TCNT1++;                            // Timer1 clocked by T1 (falling or rising edge)
+            }
+
+            Interrupt& i = s.interrupt[pin];
+            if (i.isr && ((CHANGE == i.mode) || ((FALLING == i.mode) && (LOW == level)) || ((RISING == i.mode) && (HIGH == level)))) {
+                Simulation::deliver(pin);
+            }
+        }
+    }
+
+    Simulation::now = end;
+}
+
+/**
+ * Runs (or pends) the interrupt attached to a pin.
+ *
+ * @since 2026-10-16
+ *
+ * @param pin The pin whose interrupt has been triggered
+ */
+void Simulation::deliver(uint8_t pin)
+{
+    State& s = state();
+
+    if (!s.enabled || s.isr) {
+        s.interrupt[pin].pending = true;            // AVR style: one pending flag per interrupt
+        return;
+    }
+
+    s.isr = true;                                   // interrupts are disabled within an ISR
+    s.interrupt[pin].pending = false;
+    s.interrupt[pin].isr();
+    s.isr = false;
+
+    for (uint8_t p = 0; p < SIMULATION_PINS; p++) { // handle edges that arrived in the meantime
+        if (s.interrupt[p].pending && s.enabled) {
+            Simulation::deliver(p);
+        }
+    }
+}
+
+/**
+ * Schedules a level change on an input pin.
+ *
+ * @since 2026-10-16
+ *
+ * @param pin The input pin
+ * @param level The new level
+ * @param at The moment of the level change (in µs)
+ */
+void Simulation::edge(uint8_t pin, uint8_t level, uint64_t at)
+{
+    state().edges.insert(std::make_pair(at, std::make_pair(pin, level)));
+}
+
+/**
+ * Stops the sketch after the current call to `loop()`.
+ *
+ * @since 2026-10-16
+ *
+ * @param status The exit status
+ */
+void Simulation::stop(int status)
+{
+    state().stopped = true;
+    state().status = status;
+}
+
+/**
+ * Shows whether the sketch has been stopped (or has run out of time).
+ *
+ * @since 2026-10-16
+ *
+ * @return bool
+ */
+bool Simulation::stopped()
+{
+    return state().stopped || (Simulation::now >= Simulation::runtime);
+}
+
+/**
+ * Returns the exit status of the sketch.
+ *
+ * @since 2026-10-16
+ *
+ * @return int
+ */
+int Simulation::status()
+{
+    return state().status;
+}
+
+/**
+ * Returns the host's clock, e.g. for profiling (the simulated time stands still while code runs).
+ *
+ * @since 2026-10-16
+ *
+ * @return uint32_t The host's time (in ns, wrapping around like `micros()`)
+ */
+uint32_t Simulation::ticks()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Connects a simulated fan.
+ *
+ * @since 2026-10-16
+ *
+ * @param fan The simulated fan
+ */
+void Simulation::attach(SimulatedFan* fan)
+{
+    state().fans.push_back(fan);
+}
+
+/**
+ * Injects received serial data.
+ *
+ * @since 2026-10-16
+ *
+ * @param data The received data
+ * @param size The number of received bytes
+ */
+void Simulation::input(const char* data, uint16_t size)
+{
+    state().input.insert(state().input.end(), data, data + size);
+}
+
+uint8_t Simulation::level(uint8_t pin) { return (pin < SIMULATION_PINS) ? state().level[pin] : LOW; }
+uint8_t Simulation::analog(uint8_t pin) { return (pin < SIMULATION_PINS) ? state().analog[pin] : 0; }
+/**
+ * Returns the duty cycle of a pin, either from its timer output compare unit (in PWM mode with TOP = ICRn) or via `analogWrite()`.
+ *
+ * @since 2026-10-16
+ *
+ * @param pin The output pin
+ *
+ * @return float The duty cycle (in %)
+ */
+float Simulation::duty(uint8_t pin)
+{
+    bool timer1 = (TCCR1B & _BV(WGM13)) && ICR1;    // Timer1 in PWM mode 10 or 14
+    bool timer3 = (TCCR3B & _BV(WGM33)) && ICR3;    // Timer3 in PWM mode 10 or 14
+
+    if (timer1 && (9 == pin) && (TCCR1A & _BV(COM1A1))) return min(OCR1A, ICR1) * 100.0f / ICR1;
+    if (timer1 && (10 == pin) && (TCCR1A & _BV(COM1B1))) return min(OCR1B, ICR1) * 100.0f / ICR1;
+    if (timer1 && (11 == pin) && (TCCR1A & _BV(COM1C1))) return min(OCR1C, ICR1) * 100.0f / ICR1;
+    if (timer3 && (5 == pin) && (TCCR3A & _BV(COM3A1))) return min(OCR3A, ICR3) * 100.0f / ICR3;
+
+    return Simulation::analog(pin) * 100.0f / 255.0f;
+}
+
+void Simulation::setAnalog(uint8_t pin, uint8_t value) { if (pin < SIMULATION_PINS) state().analog[pin] = value; }
+bool Simulation::interruptsEnabled() { return state().enabled && !state().isr; }
+
+void Simulation::setInterrupt(uint8_t num, void (*isr)(void), int mode)
+{
+    if (num < SIMULATION_PINS) {
+        state().interrupt[num].isr = isr;
+        state().interrupt[num].mode = mode;
+        state().interrupt[num].pending = false;
+    }
+}
+
+void Simulation::setInterrupts(bool enabled)
+{
+    State& s = state();
+
+    if (enabled && !s.enabled && !s.isr && Simulation::critical) {
+        Simulation::advance(Simulation::critical);  // the critical section takes time (edges arriving meanwhile are kept pending)
+    }
+
+    s.enabled = enabled;
+
+    if (enabled && !s.isr) {                        // deliver interrupts pending while disabled
+        for (uint8_t p = 0; p < SIMULATION_PINS; p++) {
+            if (s.interrupt[p].pending && s.interrupt[p].isr) {
+                Simulation::deliver(p);
+            }
+        }
+    }
+}
+
+/**
+ * Reads received serial data (used by the simulated serial port).
+ */
+int simulationRead(bool peek)
+{
+    State& s = state();
+
+    if (s.input.empty()) {
+        return -1;
+    }
+
+    int c = s.input.front();
+    if (!peek) {
+        s.input.pop_front();
+    }
+
+    return c;
+}
+
+int simulationAvailable()
+{
+    return state().input.size();
+}
@@ -0,0 +1,62 @@
+/**
+ * Four Wire Fan
+ *
+ * A simulated Arduino core for building and running the library natively (i.e. without hardware).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 16.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef __SIMULATION_H__
+#define __SIMULATION_H__
+
+#include <stdint.h>
+
+#define SIMULATION_PINS 32                         // number of simulated pins (and interrupts)
+#define SIMULATION_T1_PIN 12                       // Timer1 external clock input (T1)
+
+class SimulatedFan;
+
+/**
+ * The simulated microcontroller: clock, pins, interrupts and any connected fans.
+ *
+ * Time only advances when the sketch waits (`delay()`, `delayMicroseconds()`) and between two calls to `loop()`.
+ * Tach edges are delivered as interrupts in chronological order while time advances.
+ * Just like on an AVR, an edge arriving while interrupts are disabled is kept pending (once) until they are enabled again.
+ * Critical sections take no time by default, see `critical` to let edges arrive within them.
+ * Timer1 counts edges on its T1 pin when clocked externally (see `avr/io.h`).
+ * Timer1 and Timer3 drive their output compare pins in PWM mode with TOP = ICRn (i.e. pins 9, 10, 11 and 5).
+ * Since the simulated time stands still while code runs, code is profiled by the host's clock (see `FOURWIREFAN_PROFILE`).
+ */
+class Simulation {
+    public:
+        static uint64_t now;                        // the simulated time since reset (in µs)
+        static uint32_t step;                       // the plant model resolution (in µs, default: 50)
+        static uint32_t loopTime;                   // the time spent by a single call to `loop()` (in µs, default: 10)
+        static uint64_t runtime;                    // the simulated time until the sketch is stopped (in µs, default: 60s)
+        static uint32_t critical;                   // the time spent within each critical section (in µs, default: 0)
+
+        static void advance(uint64_t us);           // advances the simulated time, running the plant(s) and delivering interrupts
+        static void edge(uint8_t pin, uint8_t level, uint64_t at); // schedules a level change on an input pin
+        static void stop(int status = 0);           // stops the sketch after the current call to `loop()`
+        static bool stopped();                      // shows whether the sketch has been stopped (or has run out of time)
+        static int status();                        // returns the exit status of the sketch
+        static uint32_t ticks();                    // returns the host's clock (in ns, e.g. for profiling, see below)
+
+        static void attach(SimulatedFan* fan);      // connects a simulated fan
+        static void input(const char* data, uint16_t size); // injects received serial data
+
+        static uint8_t level(uint8_t pin);          // returns the current level of a pin
+        static uint8_t analog(uint8_t pin);         // returns the latest `analogWrite()` value of a pin
+        static float duty(uint8_t pin);             // returns the duty cycle of a pin (in %, via timer PWM or `analogWrite()`)
+        static void setAnalog(uint8_t pin, uint8_t value);
+        static void setInterrupt(uint8_t num, void (*isr)(void), int mode);
+        static void setInterrupts(bool enabled);
+        static bool interruptsEnabled();
+
+    protected:
+        static void deliver(uint8_t pin);           // runs (or pends) the interrupt attached to a pin
+};
+
+#endif  // __SIMULATION_H__
@@ -0,0 +1,60 @@
+/**
+ * Four Wire Fan
+ *
+ * Simulated AVR registers (a subset of the ATmega32U4, as on the Pro Micro).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 16.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _AVR_IO_H_
+#define _AVR_IO_H_
+
+#include <stdint.h>
+
+#ifndef __AVR_ATmega32U4__
+#define __AVR_ATmega32U4__ 1                       // the simulated microcontroller
+#endif
+
+#ifndef F_CPU
+#define F_CPU 16000000UL                           // the simulated clock frequency
+#endif
+
+#define _BV(bit) (1 << (bit))
+
+#define E2END 0x3FF                                // the last EEPROM address (1 KB)
+
+/* Timer1 (16 bit) */
+extern volatile uint8_t TCCR1A;
+extern volatile uint8_t TCCR1B;
+extern volatile uint16_t TCNT1;
+extern volatile uint16_t ICR1;
+extern volatile uint16_t OCR1A;
+extern volatile uint16_t OCR1B;
+extern volatile uint16_t OCR1C;
+
+#define WGM10 0
+#define WGM11 1
+#define COM1C1 3
+#define COM1B1 5
+#define COM1A1 7
+#define CS10 0
+#define CS11 1
+#define CS12 2
+#define WGM12 3
+#define WGM13 4
+
+/* Timer3 (16 bit) */
+extern volatile uint8_t TCCR3A;
+extern volatile uint8_t TCCR3B;
+extern volatile uint16_t ICR3;
+extern volatile uint16_t OCR3A;
+
+#define WGM30 0
+#define WGM31 1
+#define COM3A1 7
+#define CS30 0
+#define WGM33 4
+
+#endif  // _AVR_IO_H_
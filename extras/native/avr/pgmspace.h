@@ -0,0 +1,27 @@
+/**
+ * Four Wire Fan
+ *
+ * Simulated program memory access (there's just one address space natively).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 16.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef __PGMSPACE_H_
+#define __PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM                                    // no separate flash address space
+#define PSTR(s) (s)
+#define F(s) (s)
+
+#define pgm_read_byte(addr) (*(const uint8_t*) (addr))
+#define pgm_read_word(addr) (*(const uint16_t*) (addr))
+#define pgm_read_dword(addr) (*(const uint32_t*) (addr))
+#define memcpy_P(dest, src, n) memcpy((dest), (src), (n))
+#define strncmp_P(s1, s2, n) strncmp((s1), (s2), (n))
+
+#endif  // __PGMSPACE_H_
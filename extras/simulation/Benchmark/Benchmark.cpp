@@ -0,0 +1,131 @@
+/**
+ * Measures the cost of the library's hot path natively (host cycles, not AVR cycles). Fails unless the integer conversions are
+ * within rounding and the compile time configuration uses no heap and no more RAM (the timings aren't checked, they vary by host).
+ *
+ * Build and run natively (no hardware required): `pio run -e native_benchmark -t exec`
+ *
+ * For the flash footprint on the actual hardware, compare the output of `pio run -e simple` and `pio run -e template` ("Flash: … bytes").
+ */
+
+#include <chrono>
+#include "Arduino.h"
+#include <FourWireFan.h>   // https://github.com/sekdiy/FourWireFan
+#include <FourWireFanT.h>
+
+// number of calls per measurement
+const uint32_t calls = 10000000;
+
+// keeps the compiler from optimising the measured code away
+volatile uint32_t sink;
+volatile uint32_t input = 123;
+
+// the speed and duty conversions as they were, in floating point…
+__attribute__((noinline)) uint32_t floatRPM(uint32_t pulses, uint32_t elapsed) { return (uint32_t) (pulses * 60.0f / 2.0f / (elapsed / 1000000.0f)); }
+__attribute__((noinline)) uint32_t floatDuty(uint8_t pwm) { return 2.55f * pwm; }
+
+// …and as they are now, in integer arithmetic
+__attribute__((noinline)) uint32_t fixedRPM(uint32_t pulses, uint32_t elapsed) { return FourWireFan::pulsesToRPM(pulses, elapsed, 2); }
+__attribute__((noinline)) uint32_t fixedDuty(uint8_t pwm) { return FourWireFan::toAnalog(FourWireFan::toDuty(pwm)); } // (as `setPWM()` and `write()`)
+
+// counts heap allocations (and their bytes)
+uint32_t allocations = 0;
+size_t allocated = 0;
+__attribute__((noinline)) void* operator new(size_t size) { allocations++; allocated += size; return malloc(size); }
+__attribute__((noinline)) void operator delete(void* p) noexcept { free(p); }
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept { free(p); }
+
+// the same fan, configured at runtime…
+void runtimeISR();
+FourWireFan* Runtime;
+void runtimeISR() { Runtime->count(); }
+
+// …and at compile time (whose RAM is all in its static state)
+typedef FourWireFanT<3, 2, NF_A12_25_ConstModel, 0> StaticFan;
+StaticFan Static;
+struct StaticRAM : StaticFan { static constexpr size_t size = sizeof(StaticFan::State); };
+
+// returns the mean duration of a call (in ns)
+template <typename F>
+double measure(F f) {
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < calls; i++) {
+        sink = f(i);
+    }
+
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / calls;
+}
+
+void report(const char* name, double before, double after) {
+    Serial.println("  " + String(name) + ": " + String(before, 2) + " ns (float) vs. " + String(after, 2) + " ns (integer)");
+}
+
+void report2(const char* name, double runtime, double fixed) {
+    Serial.println("  " + String(name) + ": " + String(runtime, 2) + " ns vs. " + String(fixed, 2) + " ns");
+}
+
+void setup() {
+    Serial.begin(115200);
+
+    Serial.println("Conversion cost per call (host, i.e. with an FPU, unlike an AVR):");
+
+    report("pulses to rpm", measure([](uint32_t i) { return floatRPM(input + (i & 63), 1000000 + (i & 1023)); }),
+                            measure([](uint32_t i) { return fixedRPM(input + (i & 63), 1000000 + (i & 1023)); }));
+    report("percent to duty", measure([](uint32_t i) { return floatDuty(i % 101); }),
+                              measure([](uint32_t i) { return fixedDuty(i % 101); }));
+
+    Serial.println("Largest deviation of integer conversion from exact value:");
+
+    double rpm = 0.0;
+    double duty = 0.0;
+    for (uint32_t pulses = 1; pulses < 20000; pulses += 7) {
+        rpm = max(rpm, fabs(fixedRPM(pulses, 1000000) - pulses * 30.0) / (pulses * 30.0));
+    }
+    for (uint8_t pwm = 0; pwm <= 100; pwm++) {
+        duty = max(duty, fabs(fixedDuty(pwm) - pwm * 2.55));
+    }
+    Serial.println("  " + String(rpm * 1000000.0, 0) + " ppm of speed, " + String(duty, 2) + " duty steps (i.e. rounded, the float conversion truncates)");
+
+    Serial.println("Runtime (FourWireFan) vs. compile time (FourWireFanT) configuration:");
+
+    Simulation::interruptsEnabled();                // (the simulated core allocates its own state on first use)
+    uint32_t before = allocations;
+    size_t bytes = allocated;
+    Runtime = new FourWireFan(3, 2, &runtimeISR);
+    Runtime->setModel(&NF_A12_25_FanModel)->setDebounceTime(0);
+    uint32_t dynamic = allocations - before;
+    size_t runtimeRAM = allocated - bytes;          // (the fan, its settings and its model)
+    Static.begin();
+    uint32_t fixed = allocations - before - dynamic;
+    size_t staticRAM = StaticRAM::size + sizeof(Static);
+
+    Serial.println("  heap allocations: " + String(dynamic) + " vs. " + String(fixed));
+    Serial.println("  RAM (host bytes): " + String(runtimeRAM) + " vs. " + String(staticRAM));
+
+    void (* volatile isr)(void) = &runtimeISR;      // as called by the core's interrupt dispatch
+    void (* volatile staticISR)(void) = &StaticFan::count;
+
+    report2("count()", measure([&](uint32_t) { isr(); return 0; }), measure([&](uint32_t) { staticISR(); return 0; }));
+    report2("update()", measure([](uint32_t) { Runtime->update(100); return 0; }), measure([](uint32_t) { Static.update(100); return 0; }));
+    report2("setRPM()", measure([](uint32_t i) { Runtime->setRPM(input + (i & 1023)); return 0; }), measure([](uint32_t i) { Static.setRPM(input + (i & 1023)); return 0; }));
+
+    uint16_t differ = 0, most = 0;
+    for (uint16_t rpm = 0; rpm < 2000; rpm++) {
+        int16_t difference = abs((int16_t) NF_A12_25_FanModel.toPWM(rpm) - (int16_t) NF_A12_25_ConstModel::toPWM(rpm));
+        differ += (0 < difference);
+        most = max(most, (uint16_t) difference);
+    }
+    Serial.println("  model lookups (0 .. 2000 rpm): " + String(differ) + " differ by up to " + String(most) + "% (rounding)");
+
+    bool passed = (rpm < 0.001) && (duty < 0.501) && (most <= 1) && (0 == fixed) && (staticRAM <= runtimeRAM);
+
+    if (!passed) {
+        Serial.println("  FAILED");
+    }
+
+    Simulation::stop(passed ? 0 : 1);
+}
+
+void loop() {
+    // all measurements run from setup()
+}
@@ -0,0 +1,87 @@
+/**
+ * Calibrates a simulated fan and compares the measured model with the actual fan.
+ *
+ * Build and run natively (no hardware required): `pio run -e native_calibration -t exec`
+ */
+
+#include "Arduino.h"
+#include <FourWireFan.h>             // https://github.com/sekdiy/FourWireFan
+#include <FourWireFanCalibration.h>
+#include "SimulatedFan.h"
+
+// update period (in ms, i.e. 10 Hz)
+const unsigned long period = 100;
+
+// the largest deviation of measured reference points from the actual ones, and of extrapolated ones (in %)
+const uint8_t measured = 3;
+const uint8_t extrapolated = 8;
+
+// the actual fan: stalls below 12%, needs 25% to break away
+uint16_t actualRPM[10] = {310, 520, 760, 980, 1170, 1340, 1490, 1610, 1720, 1810};
+SimulatedFan Plant(3, 2, 1810, 600);
+
+// the fan driver, starting with the default model
+void fanISR();
+FourWireFanSettings Settings(3, 2, &fanISR, FALLING, INPUT_PULLUP, 1000L, FOURWIREFAN_PERIOD);
+FourWireFanModel Model;
+FourWireFan* Fan;
+FourWireFanCalibration* Calibration;
+void fanISR() { Fan->count(); }
+
+unsigned long start;
+
+void setup() {
+    Serial.begin(115200);
+
+    Plant.refRPM = actualRPM;
+    Plant.stallPWM = 12;
+    Plant.startPWM = 25;
+    Plant.minRPM = actualRPM[0];
+    Plant.jitter = 5;
+
+    Fan = new FourWireFan(&Settings, &Model);
+    Calibration = new FourWireFanCalibration(Fan);
+
+    Serial.println("Calibration (10 Hz updates, 2% tolerance, 500 ms windows):");
+
+    start = millis();
+    Calibration->begin(&Model);
+}
+
+void loop() {
+    if (!Fan->poll(period)) {
+        return;                                     // nothing else to do here
+    }
+
+    if (Calibration->update()) {
+        return;                                     // still calibrating (without blocking the loop)
+    }
+
+    if (FOURWIREFAN_DONE != Calibration->getState()) {
+        Serial.println("  failed");
+        Simulation::stop(1);
+        return;
+    }
+
+    Serial.println("  done after " + String(millis() - start) + " ms");
+
+    bool passed = true;
+
+    for (uint8_t i = 0; i < 10; i++) {
+        bool stalled = ((i + 1) * 10 < Plant.stallPWM);
+        int32_t error = abs((int32_t) Model.refRPM[i] - (int32_t) actualRPM[i]) * 100 / actualRPM[i];
+        bool ok = (error <= (stalled ? extrapolated : measured));
+
+        Serial.println("  " + String((i + 1) * 10) + "%: " + String(Model.refRPM[i]) + " rpm " + (stalled ? "extrapolated" : "measured")
+            + ", " + String(actualRPM[i]) + " rpm actual" + (ok ? "" : " WRONG"));
+
+        passed = passed && ok;
+    }
+
+    Serial.println("  minPWM " + String(Model.minPWM) + "% (stalls below " + String(Plant.stallPWM) + "%), minRPM " + String(Model.minRPM)
+        + " rpm, spin-up " + String(Model.spinup) + " ms");
+
+    passed = passed && (Model.minPWM == Plant.stallPWM) && (0 < Model.spinup);
+
+    Simulation::stop(passed ? 0 : 1);
+}
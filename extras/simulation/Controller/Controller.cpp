@@ -0,0 +1,119 @@
+/**
+ * Holds a simulated fan at a target speed, reports settling time and overshoot and fails unless both are within limits.
+ *
+ * Build and run natively (no hardware required): `pio run -e native_controller -t exec`
+ */
+
+#include "Arduino.h"
+#include <FourWireFan.h>             // https://github.com/sekdiy/FourWireFan
+#include <FourWireFanController.h>
+#include "SimulatedFan.h"
+
+// control loop period (in ms, i.e. 10 Hz)
+const unsigned long period = 100;
+
+// the fan model (as specified)…
+uint16_t modelRPM[10] = {240, 420, 660, 870, 1080, 1260, 1400, 1500, 1600, 1700};
+FourWireFanModel Model(10, 240, 100, 1700, 1000, modelRPM);
+
+// …and the actual fan (somewhat faster than specified, then slowed down by back-pressure)
+uint16_t freeRPM[10] = {260, 470, 720, 940, 1150, 1330, 1480, 1580, 1680, 1780};
+uint16_t loadedRPM[10] = {200, 360, 570, 760, 940, 1100, 1230, 1330, 1420, 1500};
+SimulatedFan Plant(3, 2, 1780, 400);
+
+void fanISR();
+FourWireFanSettings Settings(3, 2, &fanISR, FALLING, INPUT_PULLUP, 1000L, FOURWIREFAN_PERIOD);
+FourWireFan* Fan;
+FourWireFanController* Controller;
+void fanISR() { Fan->count(); }
+
+// the limits a step response has to stay within
+const unsigned long maxSettling = 3000;     // (in ms)
+const uint8_t maxOvershoot = 15;            // (in % of the target)
+
+// runs the loop for a while, reporting overshoot and the time until the speed stays within 2% of the target, returns whether within limits
+bool track(uint16_t target, unsigned long duration) {
+    unsigned long start = millis();
+    unsigned long settled = 0;
+    uint32_t from = 0;
+    uint32_t peak = 0;
+    bool approaching = false;                   // (the spin-up kick isn't the controller's overshoot)
+
+    Controller->setTarget(target);
+
+    while (millis() - start < duration) {
+        delay(period);
+        Fan->update(period);
+        Controller->update(period);
+
+        uint32_t rpm = Fan->getRPM();
+
+        if (Fan->isBlocked()) {
+            settled = millis() - start;
+            continue;
+        }
+
+        if (!approaching) {                     // the approach starts with the first controlled update
+            approaching = true;
+            from = rpm;
+            peak = rpm;
+        }
+
+        peak = (target > from) ? max(peak, rpm) : min(peak, rpm);
+
+        if (abs((int32_t) rpm - (int32_t) target) > target / 50) {
+            settled = millis() - start;
+        }
+    }
+
+    if (!approaching) {
+        Serial.println("  -> " + String(target) + " rpm: still spinning up after " + String(duration) + " ms (" + String(Fan->getPWM()) + "% set point)");
+        return false;
+    }
+
+    int32_t overshoot = max((target > from) ? (int32_t) peak - target : (int32_t) target - peak, 0L) * 100 / target;
+    bool within = (settled <= maxSettling) && (overshoot <= maxOvershoot);
+
+    Serial.println("  " + String(from) + " -> " + String(target) + " rpm: settled after " + String(settled) + " ms, overshoot "
+        + String(overshoot) + "% (" + String(Fan->getPWM()) + "% duty)" + (within ? "" : " OUT OF LIMITS"));
+
+    return within;
+}
+
+void setup() {
+    Serial.begin(115200);
+
+    Plant.refRPM = freeRPM;
+    Plant.stallPWM = 5;
+    Plant.startPWM = 15;
+
+    Fan = new FourWireFan(&Settings, &Model);
+    Controller = new FourWireFanController(Fan);
+
+    bool passed = true;
+
+    Serial.println("Speed control at 10 Hz:");
+
+    passed = track(800, 5000) && passed;
+    passed = track(1400, 5000) && passed;
+    passed = track(600, 5000) && passed;
+
+    Serial.println("Back-pressure:");
+
+    Plant.refRPM = loadedRPM;
+    passed = track(600, 5000) && passed;
+    passed = track(1200, 5000) && passed;
+
+    Serial.println("Blocked rotor:");
+
+    Plant.blocked = true;
+    passed = !track(1200, 3000) && passed;      // keeps spinning up (without winding up the integrator)…
+    Plant.blocked = false;
+    passed = track(1200, 5000) && passed;       // …and recovers once released
+
+    Simulation::stop(passed ? 0 : 1);
+}
+
+void loop() {
+    // all scenarios run from setup()
+}
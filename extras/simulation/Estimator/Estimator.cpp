@@ -0,0 +1,103 @@
+/**
+ * Compares raw speed readings with the model based estimate against the simulated ground truth, at various update periods.
+ *
+ * Build and run natively (no hardware required): `pio run -e native_estimator -t exec`
+ */
+
+#include <math.h>
+#include "Arduino.h"
+#include <FourWireFanArray.h>        // https://github.com/sekdiy/FourWireFan
+#include "SimulatedFan.h"
+
+// the measuring setups: update period (in ms), tach method and the estimator's guess of the rotor time constant (in ms)
+const uint16_t periods[] = {50, 100, 250, 1000, 50, 50};
+const uint8_t methods[] = {FOURWIREFAN_COUNTING, FOURWIREFAN_COUNTING, FOURWIREFAN_COUNTING, FOURWIREFAN_COUNTING, FOURWIREFAN_PERIOD, FOURWIREFAN_COUNTING};
+const uint16_t inertias[] = {500, 500, 500, 500, 500, 1000};
+
+// the fan model (about 5% off the actual fans, i.e. uncalibrated), six identical fans (500 ms time constant) with jittery tach edges
+FourWireFanModel Model(20, 470, 100, 1900);
+FourWireFanSettings Counting(3, 2, nullptr, FALLING, INPUT_PULLUP, 1000L, FOURWIREFAN_COUNTING);
+FourWireFanSettings Period(3, 2, nullptr, FALLING, INPUT_PULLUP, 1000L, FOURWIREFAN_PERIOD);
+FourWireFanArray<6> Fans;
+FourWireFanEstimator* Estimators[6];
+SimulatedFan* Plants[6];
+
+// the duty cycle profile: steps, a ramp, and a plateau (in %)
+uint8_t profile(unsigned long ms) {
+    if (ms < 4000) return 40;
+    if (ms < 8000) return 80;
+    if (ms < 12000) return 30;
+    if (ms < 16000) return 30 + (ms - 12000) * 60 / 4000;
+    return 60;
+}
+
+void setup() {
+    Serial.begin(115200);
+
+    Fans.add<16, 24>(&Model, Counting);
+    Fans.add<17, 25>(&Model, Counting);
+    Fans.add<18, 26>(&Model, Counting);
+    Fans.add<19, 27>(&Model, Counting);
+    Fans.add<20, 28>(&Model, Period);
+    Fans.add<21, 29>(&Model, Counting);
+
+    double raw[6] = {0}, estimated[6] = {0};
+    uint32_t samples[6] = {0};
+
+    for (uint8_t i = 0; i < 6; i++) {
+        Plants[i] = new SimulatedFan(16 + i, 24 + i, 2000, 500);
+        Plants[i]->jitter = 5;
+        Plants[i]->setRPM(1100);
+        Estimators[i] = new FourWireFanEstimator(inertias[i]);
+        Fans[i]->setEstimator(Estimators[i]);
+    }
+
+    Fans.reset();
+
+    unsigned long start = millis();
+
+    while (millis() - start < 20000) {
+        delay(5);
+
+        for (uint8_t i = 0; i < 6; i++) {
+            Fans[i]->setPWM(profile(millis() - start));
+
+            if (!Fans[i]->poll(periods[i]) || (millis() - start < 2000)) {
+                continue;                           // (not due, or still settling)
+            }
+
+            double truth = Plants[i]->getRPM();
+
+            raw[i] += sq(Fans[i]->getRawRPM() - truth);
+            estimated[i] += sq(Fans[i]->getRPM() - truth);
+            samples[i]++;
+        }
+    }
+
+    Serial.println("Speed error against ground truth (RMS, 20 s of steps and ramps, model 5% off, 5% tach jitter):");
+
+    bool passed = true;
+
+    for (uint8_t i = 0; i < 6; i++) {
+        float before = sqrt(raw[i] / samples[i]);
+        float after = sqrt(estimated[i] / samples[i]);
+        bool fast = (periods[i] <= 250) && (500 == inertias[i]);
+
+        // the estimate is never worse than the raw reading, within 30 rpm if updated often (and the time constant guessed right),
+        // and it learns that the fans run faster than their model says
+        bool better = (after <= before) && (!fast || (after <= 30)) && (0 < Estimators[i]->getOffset());
+
+        Serial.println("  " + String(periods[i]) + " ms, " + String(FOURWIREFAN_PERIOD == methods[i] ? "edge timing" : "pulse counting")
+            + ((500 == inertias[i]) ? String("") : ", time constant guessed at " + String(inertias[i]) + " ms")
+            + ": raw " + String(before, 0) + " rpm, estimate " + String(after, 0) + " rpm (model offset learnt: "
+            + String(Estimators[i]->getOffset()) + " rpm)" + (better ? "" : " FAILED"));
+
+        passed = passed && better;
+    }
+
+    Simulation::stop(passed ? 0 : 1);
+}
+
+void loop() {
+    // all scenarios run from setup()
+}
@@ -0,0 +1,118 @@
+/**
+ * Stalls eight simulated fans at once (e.g. a brown-out) and compares their restart with and without a duty budget.
+ *
+ * Build and run natively (no hardware required): `pio run -e native_group -t exec`
+ */
+
+#include "Arduino.h"
+#include <FourWireFanArray.h>        // https://github.com/sekdiy/FourWireFan
+#include "SimulatedFan.h"
+
+// update period (in ms, i.e. 10 Hz)
+const unsigned long period = 100;
+
+// a fan model with a spin-up of 1 s at full duty, and eight fans (set to 25%, i.e. below their break away duty)
+FourWireFanModel Model(20, 400, 100, 2000, 1000);
+FourWireFanSettings Settings(3, 2, nullptr, FALLING, INPUT_PULLUP, 1000L, FOURWIREFAN_PERIOD);
+FourWireFanArray<8> Fans;
+SimulatedFan* Plants[8];
+
+// the sum of all applied duty cycles (in %)
+float total() {
+    float sum = 0;
+
+    for (uint8_t i = 0; i < 8; i++) {
+        sum += Plants[i]->getDuty();
+    }
+
+    return sum;
+}
+
+// blocks all rotors for half a second (i.e. they all stall at once), then reports the restart, returns whether all fans were
+// kicked (within the budget) and running again within 3 s
+bool brownout(uint16_t budget) {
+    unsigned long start = millis();
+    unsigned long kicked[8] = {0};
+    unsigned long running = 0;
+    float step = 0;
+
+    Fans.setBudget(budget);
+
+    for (uint8_t i = 0; i < 8; i++) {
+        Plants[i]->blocked = true;
+    }
+
+    while (millis() - start < 6000) {
+        float before = total();
+
+        delay(period);
+        Fans.update(period);
+
+        step = max(step, total() - before);
+
+        if (millis() - start >= 500) {
+            for (uint8_t i = 0; i < 8; i++) {
+                Plants[i]->blocked = false;
+            }
+        }
+
+        bool all = true;
+        for (uint8_t i = 0; i < 8; i++) {
+            if (!kicked[i] && (Plants[i]->getDuty() > 99)) {
+                kicked[i] = millis() - start;
+            }
+            all = all && !Fans[i]->isBlocked() && (Fans[i]->getRPM() > Model.minRPM);
+        }
+        if (all && !running) {
+            running = millis() - start;
+        }
+    }
+
+    String order = "";
+    bool passed = running && (running <= 3000) && (!budget || (step <= budget + 0.5f));
+    for (uint8_t i = 0; i < 8; i++) {
+        order += String(kicked[i]) + ((i < 7) ? ", " : " ms");
+        passed = passed && kicked[i];
+    }
+
+    Serial.println("  " + (budget ? String(budget) + "% budget" : String("no budget")) + ": largest step " + String(step, 0)
+        + "% (total duty), all running again after " + String(running) + " ms" + (passed ? "" : " FAILED"));
+    Serial.println("    kicked after " + order);
+
+    return passed;
+}
+
+void setup() {
+    Serial.begin(115200);
+
+    Fans.add<16, 24>(&Model, Settings);
+    Fans.add<17, 25>(&Model, Settings);
+    Fans.add<18, 26>(&Model, Settings);
+    Fans.add<19, 27>(&Model, Settings);
+    Fans.add<20, 28>(&Model, Settings);
+    Fans.add<21, 29>(&Model, Settings);
+    Fans.add<22, 30>(&Model, Settings);
+    Fans.add<23, 31>(&Model, Settings);
+
+    for (uint8_t i = 0; i < 8; i++) {
+        Plants[i] = new SimulatedFan(16 + i, 24 + i, 2000, 300 + 40 * i);
+        Plants[i]->setRPM(600);
+        Fans[i]->setPWM(25);
+    }
+
+    Fans.reset();
+
+    Serial.println("Brown-out of eight fans at 25% duty (spin-up: 1000 ms at 100%):");
+
+    bool passed = true;
+
+    passed = brownout(0) && passed;
+    passed = brownout(200) && passed;
+    passed = brownout(100) && passed;
+
+    Simulation::stop(passed ? 0 : 1);
+}
+
+void loop() {
+    // all scenarios run from setup()
+}
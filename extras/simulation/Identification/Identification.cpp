@@ -0,0 +1,211 @@
+/**
+ * Identifies a mixed set of simulated fans against the library of fan models, rejects a fan unlike any of them, then reads a
+ * three wire fan with and without pulse stretching.
+ *
+ * Build and run natively (no hardware required): `pio run -e native_identification -t exec`
+ */
+
+#include "Arduino.h"
+#include <FourWireFanArray.h>        // https://github.com/sekdiy/FourWireFan
+#include <FourWireFanIdentification.h>
+#include "SimulatedFan.h"
+
+// update period (in ms, i.e. 10 Hz)
+const unsigned long period = 100;
+
+// the fans as they are (i.e. the ground truth), each resembling a preset
+struct Fan {
+    const char* preset;    // the preset it should be identified as
+    uint16_t maxRPM;       // its actual maximum speed (within the preset's tolerance)
+    uint8_t stallPWM;      // its actual stall point
+    uint16_t inertia;      // its actual rotor time constant (in ms)
+    uint8_t wires;         // three or four wire fan
+};
+
+Fan fans[4] = {
+    {"NF-A12x25 PWM",      1680,  4,  650, 4},
+    {"NF-A4x10 5V PWM",    4800, 14,  150, 4},
+    {"P14 PWM",            1650,  4,  800, 4},
+    {"Silent Wings 3 120", 1500, 14,  650, 4},
+};
+
+// a fan unlike any preset (a fast server fan)
+Fan unknown = {"(none)", 9000, 25, 300, 4};
+void unknownISR();
+FourWireFanSettings UnknownSettings(20, 28, &unknownISR, FALLING, INPUT_PULLUP, 1000L, FOURWIREFAN_PERIOD);
+FourWireFanModel UnknownModel;
+FourWireFan* Unknown;
+void unknownISR() { Unknown->count(); }
+
+// a three wire fan (its tach pulses are chopped by the PWM)
+Fan redux = {"NF-P12 redux-1300", 1250, 35, 1000, 3};
+
+FourWireFanSettings FourWire(3, 2, nullptr, FALLING, INPUT_PULLUP, 1000L, FOURWIREFAN_PERIOD);
+
+// three wire fans need a tach window (and measure by edge timing within it)
+FourWireFanSettings ThreeWire(3, 2, nullptr, FALLING, INPUT_PULLUP, 1000L, FOURWIREFAN_PERIOD, nullptr, FOURWIREFAN_ANALOGWRITE, FOURWIREFAN_FIXED, 200);
+
+// the same three wire fan, once read within a tach window (spanning a few pulses) and once without
+void stretchedISR();
+void choppedISR();
+FourWireFanSettings StretchedSettings(21, 29, &stretchedISR, FALLING, INPUT_PULLUP, 1000L, FOURWIREFAN_PERIOD, nullptr, FOURWIREFAN_ANALOGWRITE, FOURWIREFAN_FIXED, 200);
+FourWireFanSettings ChoppedSettings(22, 30, &choppedISR, FALLING, INPUT_PULLUP, 1000L, FOURWIREFAN_PERIOD);
+FourWireFanModel ThreeWireModel;
+FourWireFan* Stretched;
+FourWireFan* Chopped;
+void stretchedISR() { Stretched->count(); }
+void choppedISR() { Chopped->count(); }
+
+FourWireFanModel Models[4];
+FourWireFanArray<4> Fans;
+
+// connects a simulated fan
+SimulatedFan* plant(uint8_t pwmPin, uint8_t tachPin, Fan& fan) {
+    SimulatedFan* p = new SimulatedFan(pwmPin, tachPin, fan.maxRPM, fan.inertia);
+    p->minRPM = fan.maxRPM / 5;
+    p->stallPWM = fan.stallPWM;
+    p->startPWM = fan.stallPWM + 10;
+    p->wires = fan.wires;
+    return p;
+}
+
+// identifies all fans at once, returns the number identified correctly
+uint8_t identify() {
+    FourWireFanIdentification* identifications[4];
+    bool running = true;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        identifications[i] = new FourWireFanIdentification(Fans[i]);
+        identifications[i]->begin(&Models[i]);
+    }
+
+    unsigned long start = millis();
+
+    while (running) {
+        delay(period);
+        Fans.update(FOURWIREFAN_ELAPSED);
+
+        running = false;
+        for (uint8_t i = 0; i < 4; i++) {
+            running = identifications[i]->update() || running;
+        }
+    }
+
+    uint8_t correct = 0;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        FourWireFanIdentification* id = identifications[i];
+        FourWireFanPreset preset;
+        bool found = FourWireFanLibrary::get(id->getPreset(), &preset);
+        bool match = found && !strcmp(preset.name, fans[i].preset) && (fans[i].wires == id->getWires());
+
+        correct += match ? 1 : 0;
+
+        Serial.println("  " + String(fans[i].preset) + ": runs down to " + String(id->getStallPWM()) + "%, " + String(id->getMaxRPM())
+            + " rpm, half speed after " + String(id->getRampup()) + " ms -> " + (found ? String(preset.name) : String("nothing"))
+            + " (distance " + String(id->getDistance()) + ")" + (match ? "" : " WRONG"));
+    }
+
+    Serial.println("  took " + String((millis() - start) / 1000) + " s");
+
+    return correct;
+}
+
+// identifies the unknown fan, returns whether it's been rejected (keeping its model)
+bool reject() {
+    FourWireFanModel* previous = Unknown->getModel();
+    FourWireFanIdentification identification(Unknown);
+
+    identification.begin(&UnknownModel);
+
+    do {
+        delay(period);
+        Unknown->update(FOURWIREFAN_ELAPSED);
+    } while (identification.update());
+
+    bool rejected = (FOURWIREFAN_FAILED == identification.getState()) && (FOURWIREFAN_NO_PRESET == identification.getPreset())
+        && (previous == Unknown->getModel());
+
+    Serial.println("  unknown fan: runs down to " + String(identification.getStallPWM()) + "%, " + String(identification.getMaxRPM())
+        + " rpm -> " + (rejected ? "nothing" : "WRONG") + " (closest at distance " + String(identification.getDistance()) + ")");
+
+    return rejected;
+}
+
+// reads both three wire fans at a given duty, returns the mean relative errors of their speed readings (in %)
+void compare(uint8_t pwm, SimulatedFan* stretchedPlant, SimulatedFan* choppedPlant, uint32_t* stretched, uint32_t* chopped) {
+    uint32_t count[2] = {0, 0}, error[2] = {0, 0};
+    unsigned long start = millis();
+
+    Stretched->setPWM(pwm);
+    Chopped->setPWM(pwm);
+
+    while (millis() - start < 20000) {
+        delay(1);
+
+        bool settled = (millis() - start > 5000);
+        float truth = stretchedPlant->getRPM();     // (both plants are alike)
+
+        if (Stretched->poll(1000) && settled) {
+            error[0] += abs((int32_t) Stretched->getRawRPM() - (int32_t) truth) * 100 / max((int32_t) truth, (int32_t) 1);
+            count[0]++;
+        }
+
+        truth = choppedPlant->getRPM();
+
+        if (Chopped->poll(1000) && settled) {
+            error[1] += abs((int32_t) Chopped->getRawRPM() - (int32_t) truth) * 100 / max((int32_t) truth, (int32_t) 1);
+            count[1]++;
+        }
+    }
+
+    *stretched = count[0] ? error[0] / count[0] : 0;
+    *chopped = count[1] ? error[1] / count[1] : 0;
+}
+
+void setup() {
+    Serial.begin(115200);
+
+    Fans.add<16, 24>(&Models[0], FourWire);
+    Fans.add<17, 25>(&Models[1], FourWire);
+    Fans.add<18, 26>(&Models[2], FourWire);
+    Fans.add<19, 27>(&Models[3], FourWire);
+
+    for (uint8_t i = 0; i < 4; i++) {
+        plant(16 + i, 24 + i, fans[i]);            // (connected for good)
+    }
+
+    Serial.println(String(FourWireFanLibrary::size()) + " presets in flash (" + String(FourWireFanLibrary::size() * sizeof(FourWireFanPreset))
+        + " bytes), identifying a mixed set of fans:");
+
+    uint8_t correct = identify();
+
+    Unknown = new FourWireFan(&UnknownSettings);
+    plant(20, 28, unknown);
+
+    bool rejected = reject();
+
+    FourWireFanLibrary::load(FourWireFanLibrary::find("NF-P12 redux-1300"), &ThreeWireModel);
+
+    Stretched = new FourWireFan(&StretchedSettings, &ThreeWireModel);
+    Chopped = new FourWireFan(&ChoppedSettings, &ThreeWireModel);
+
+    SimulatedFan* stretchedPlant = plant(21, 29, redux);
+    SimulatedFan* choppedPlant = plant(22, 30, redux);
+
+    uint32_t stretched, chopped;
+
+    Serial.println("Three wire fan at 60%, read within a 200 ms tach window vs. without:");
+
+    compare(60, stretchedPlant, choppedPlant, &stretched, &chopped);
+
+    Serial.println("  stretched: " + String(stretched) + "% off, chopped: " + String(chopped) + "% off (fan at " + String(choppedPlant->getRPM(), 0) + " rpm)");
+
+    bool passed = (4 == correct) && rejected && (stretched <= 5) && (chopped >= 50);
+
+    Simulation::stop(passed ? 0 : 1);
+}
+
+void loop() {
+    // all scenarios run from setup()
+}
@@ -0,0 +1,141 @@
+/**
+ * Injects faults into a simulated fan and reports when and how the health monitor flags them, fails unless each is flagged as
+ * expected and in time (and healthy steps aren't flagged at all).
+ *
+ * Build and run natively (no hardware required): `pio run -e native_monitor -t exec`
+ */
+
+#include "Arduino.h"
+#include <FourWireFan.h>             // https://github.com/sekdiy/FourWireFan
+#include <FourWireFanMonitor.h>
+#include "SimulatedFan.h"
+
+// update period (in ms, i.e. 10 Hz)
+const unsigned long period = 100;
+
+// the fan model (as specified) and the actual fan (as new, worn out, and with a broken PWM wire, i.e. at full speed)
+uint16_t modelRPM[10] = {240, 420, 660, 870, 1080, 1260, 1400, 1500, 1600, 1700};
+uint16_t wornRPM[10] = {170, 290, 460, 610, 760, 880, 980, 1050, 1120, 1190};
+uint16_t fullRPM[10] = {1700, 1700, 1700, 1700, 1700, 1700, 1700, 1700, 1700, 1700};
+FourWireFanModel Model(10, 240, 100, 1700, 1000, modelRPM);
+SimulatedFan Plant(3, 2, 1700, 400);
+
+void fanISR();
+FourWireFanSettings Settings(3, 2, &fanISR, FALLING, INPUT_PULLUP, 1000L, FOURWIREFAN_PERIOD);
+FourWireFan* Fan;
+FourWireFanMonitor* Monitor;
+void fanISR() { Fan->count(); }
+
+const char* names[] = {"healthy", "tach lost", "stalled", "overspeed", "degraded"};
+unsigned long fault = 0;                    // the moment of the most recent fault injection (in ms)
+uint8_t changes = 0;                        // the number of callbacks since
+uint8_t wanted = FOURWIREFAN_HEALTHY;       // the expected health condition…
+unsigned long reached = 0;                  // …and when it was first reported (in ms since the injection, 0: not yet)
+
+// reports a change of health (i.e. the supervisor's hook)
+void onHealth(FourWireFan* fan, uint8_t health) {
+    changes++;
+    reached = (!reached && (wanted == health)) ? millis() - fault : reached;
+    Serial.println("    " + String(names[health]) + " after " + String(millis() - fault) + " ms ("
+        + String(fan->getRPM()) + " rpm measured, " + String(Monitor->getExpected()) + " rpm expected)");
+}
+
+// runs the loop for a while
+void run(unsigned long duration) {
+    unsigned long start = millis();
+
+    while (millis() - start < duration) {
+        delay(period);
+        Fan->update(period);
+        Monitor->update();
+    }
+}
+
+// injects a fault (or repairs it), then runs the loop for a while, returns whether the expected health was reported in time
+// (or, if unchanged, nothing at all)
+bool inject(const char* what, unsigned long duration, uint8_t health, unsigned long limit) {
+    Serial.println("  " + String(what) + ":");
+
+    bool unchanged = (health == Monitor->getHealth());
+
+    fault = millis();
+    changes = 0;
+    wanted = health;
+    reached = 0;
+    run(duration);
+
+    if (0 == changes) {
+        Serial.println("    no change, " + String(names[Monitor->getHealth()]));
+    }
+
+    bool passed = (health == Monitor->getHealth()) && (unchanged ? (0 == changes) : (reached && (reached <= limit)));
+
+    if (!passed) {
+        Serial.println("    FAILED (" + String(names[health]) + " expected within " + String(limit) + " ms)");
+    }
+
+    return passed;
+}
+
+void setup() {
+    Serial.begin(115200);
+
+    Plant.refRPM = modelRPM;
+    Plant.stallPWM = 5;
+    Plant.startPWM = 15;
+
+    Fan = new FourWireFan(&Settings, &Model);
+    Monitor = new FourWireFanMonitor(Fan);
+    Monitor->setCallback(&onHealth);
+
+    Serial.println("Health monitor (10 Hz updates, 20% tolerance, 5% hysteresis, no delay):");
+
+    bool passed = true;
+
+    Fan->setPWM(60);
+    passed = inject("healthy fan, 60% duty", 8000, FOURWIREFAN_HEALTHY, 0) && passed;
+    Fan->setPWM(20);
+    passed = inject("healthy fan, step down to 20% duty", 8000, FOURWIREFAN_HEALTHY, 0) && passed;
+    Fan->setPWM(90);
+    passed = inject("healthy fan, step up to 90% duty", 8000, FOURWIREFAN_HEALTHY, 0) && passed;
+
+    Plant.refRPM = wornRPM;
+    passed = inject("worn bearing (30% slower)", 8000, FOURWIREFAN_DEGRADED, 1000) && passed;
+    Plant.refRPM = modelRPM;
+    passed = inject("bearing replaced", 8000, FOURWIREFAN_HEALTHY, 1500) && passed;
+
+    Fan->setPWM(40);
+    run(8000);
+    Plant.refRPM = fullRPM;
+    passed = inject("broken PWM wire (full speed at 40% duty)", 8000, FOURWIREFAN_OVERSPEED, 1000) && passed;
+    Plant.refRPM = modelRPM;
+    passed = inject("PWM wire repaired", 8000, FOURWIREFAN_HEALTHY, 1500) && passed;
+
+    Plant.disconnected = true;
+    passed = inject("broken tach wire", 3000, FOURWIREFAN_TACH_LOST, 1000) && passed;
+    Plant.disconnected = false;
+    passed = inject("tach wire repaired", 3000, FOURWIREFAN_HEALTHY, 1000) && passed;
+
+    Plant.stallPWM = 101;
+    passed = inject("seized bearing (rotor grinds to a halt)", 8000, FOURWIREFAN_STALLED, 3000) && passed;
+    Plant.stallPWM = 5;
+    passed = inject("bearing replaced", 8000, FOURWIREFAN_HEALTHY, 1500) && passed;
+
+    Plant.blocked = true;
+    passed = inject("blocked rotor (stops at once, i.e. just like a broken tach wire)", 3000, FOURWIREFAN_TACH_LOST, 1000) && passed;
+    Plant.blocked = false;
+    passed = inject("rotor released", 8000, FOURWIREFAN_HEALTHY, 1500) && passed;
+
+    Plant.disconnected = true;
+    Fan->reset();
+    Monitor->reset();
+    passed = inject("fan replaced, tach wire not connected", 3000, FOURWIREFAN_TACH_LOST, FOURWIREFAN_MONITOR_STARTUP + 500) && passed;
+    Plant.disconnected = false;
+    passed = inject("tach wire connected", 3000, FOURWIREFAN_HEALTHY, 1000) && passed;
+
+    Simulation::stop(passed ? 0 : 1);
+}
+
+void loop() {
+    // all scenarios run from setup()
+}
@@ -0,0 +1,109 @@
+/**
+ * Compares a shaped fan (slew rate limited, skipping a resonance band) with an unshaped one: a step, a slow ramp through the band
+ * and a set point within it.
+ *
+ * Build and run natively (no hardware required): `pio run -e native_shaping -t exec`
+ */
+
+#include <math.h>
+#include "Arduino.h"
+#include <FourWireFanArray.h>        // https://github.com/sekdiy/FourWireFan
+#include "SimulatedFan.h"
+
+// update period (in ms, i.e. 10 Hz)
+const unsigned long period = 100;
+
+// the slew rate (in % per second), the chassis resonance and the forbidden band around it (in rpm)
+const uint8_t rate = 20;
+const uint16_t from = 920;
+const uint16_t to = 1080;
+const uint16_t margin = 20;
+
+// the actual fans' speed curve (calibrated, i.e. known to the models as well)
+const uint16_t curve[10] = {240, 420, 660, 870, 1080, 1260, 1400, 1500, 1600, 1700};
+
+FourWireFanModel Shaped(10, 240, 100, 1700, 0, (uint16_t*) curve);
+FourWireFanModel Unshaped(10, 240, 100, 1700, 0, (uint16_t*) curve);
+FourWireFanSettings Settings(3, 2, nullptr, FALLING, INPUT_PULLUP, 1000L, FOURWIREFAN_PERIOD);
+FourWireFanArray<2> Fans;
+SimulatedFan* Plants[2];
+
+// a fan's largest duty cycle step and the time its rotor spent within the band
+struct Result {
+    float step = 0.0f;
+    float previous = -1.0f;
+    unsigned long resonating = 0;
+
+    void add(SimulatedFan* plant) {
+        if (0.0f <= this->previous) {
+            this->step = max(this->step, fabsf(plant->getDuty() - this->previous));
+        }
+        this->previous = plant->getDuty();
+        this->resonating += ((from < plant->getRPM()) && (plant->getRPM() < to)) ? period : 0;
+    }
+};
+
+// runs both fans for a while, with the set point (in %) given by a function of the time (in ms)
+void run(unsigned long ms, uint8_t (*pwm)(unsigned long), Result* results) {
+    unsigned long start = millis();
+
+    results[0].previous = Plants[0]->getDuty();
+    results[1].previous = Plants[1]->getDuty();
+
+    while (millis() - start < ms) {
+        delay(period);
+        Fans[0]->setPWM(pwm(millis() - start));
+        Fans[1]->setPWM(pwm(millis() - start));
+        Fans.update(FOURWIREFAN_ELAPSED);
+        results[0].add(Plants[0]);
+        results[1].add(Plants[1]);
+    }
+}
+
+uint8_t low(unsigned long) { return 20; }
+uint8_t step(unsigned long) { return 100; }
+uint8_t ramp(unsigned long ms) { return 30 + ms * 30 / 20000; }    // 30% to 60% in 20 s (i.e. through the band)
+uint8_t resonant(unsigned long) { return 45; }                  // about 1000 rpm, i.e. within the band
+
+void setup() {
+    Serial.begin(115200);
+
+    Shaped.setBand(0, from - margin, to + margin);
+
+    Fans.add<16, 24>(&Shaped, Settings)->setSlewRate(rate, rate);
+    Fans.add<17, 25>(&Unshaped, Settings);
+
+    for (uint8_t i = 0; i < 2; i++) {
+        Plants[i] = new SimulatedFan(16 + i, 24 + i, 1700, 500);
+        Plants[i]->refRPM = curve;
+        Plants[i]->stallPWM = 5;
+        Plants[i]->minRPM = 240;
+    }
+
+    Result settle[2], steps[2], ramps[2], rests[2];
+
+    run(10000, &low, settle);
+    run(10000, &step, steps);
+    run(10000, &low, settle);
+    run(20000, &ramp, ramps);
+    run(10000, &resonant, rests);
+
+    Serial.println("Slew rate " + String(rate) + "% per second, resonance from " + String(from) + " to " + String(to) + " rpm (band "
+        + String(margin) + " rpm wider):");
+    Serial.println("  step 20% to 100%: largest duty step shaped " + String(steps[0].step, 1) + "% (crossing the band), unshaped " + String(steps[1].step, 1) + "%");
+    Serial.println("  ramp 30% to 60% in 20 s: within the band shaped " + String(ramps[0].resonating) + " ms, unshaped " + String(ramps[1].resonating) + " ms");
+    Serial.println("  set point within the band: shaped at " + String(Plants[0]->getRPM(), 0) + " rpm (" + String(Plants[0]->getDuty(), 1)
+        + "%), unshaped at " + String(Plants[1]->getRPM(), 0) + " rpm (" + String(Plants[1]->getDuty(), 1) + "%)");
+
+    float jump = Shaped.toPWM(to + margin) - Shaped.toPWM(from - margin); // (crossing the band)
+
+    bool passed = (steps[0].step <= rate * period / 1000.0f + jump + 0.5f) && (steps[1].step >= 75.0f);
+    passed = passed && (ramps[0].resonating * 4 < ramps[1].resonating);
+    passed = passed && (0 == rests[0].resonating) && (0 < rests[1].resonating);
+
+    Simulation::stop(passed ? 0 : 1);
+}
+
+void loop() {
+    // all scenarios run from setup()
+}
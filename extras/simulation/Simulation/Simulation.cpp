@@ -0,0 +1,444 @@
+/**
+ * Runs the fan driver against simulated fans: spin-up, stall recovery, debouncing, measurement latency, loop jitter, tach inputs, filters
+ * (also after a fast speed step), PWM outputs and history.
+ *
+ * Build and run natively (no hardware required): `pio run -e native -t exec`
+ */
+
+#include "Arduino.h"
+#include <FourWireFan.h>   // https://github.com/sekdiy/FourWireFan
+#include "SimulatedFan.h"
+
+// measurement update period (in ms)
+const unsigned long period = 100;
+
+// a fan that can't break away at low duty (requires a spin-up)…
+SimulatedFan StickyPlant(3, 2);
+void stickyISR();
+FourWireFanModel StickyModel(20, 400, 100, 2000, 2000);
+FourWireFanSettings StickySettings(3, 2, &stickyISR);
+FourWireFan* Sticky;
+void stickyISR() { Sticky->count(); }
+
+// …a fan whose minimum speed is below a single pulse's worth (at 100 ms, i.e. only a standstill reads as a spindown)…
+SimulatedFan StalledPlant(25, 26);
+void stalledISR();
+FourWireFanModel StalledModel(20, 240, 100, 2000, 2000);
+FourWireFanSettings StalledSettings(25, 26, &stalledISR);
+FourWireFan* Stalled;
+void stalledISR() { Stalled->count(); }
+
+// …a fan with a bouncing tach signal…
+SimulatedFan BouncyPlant(10, 4);
+void bouncyISR();
+FourWireFanSettings BouncySettings(10, 4, &bouncyISR, FALLING, INPUT_PULLUP, 1000L);
+FourWireFan* Bouncy;
+void bouncyISR() { Bouncy->count(); }
+
+// …and a pair of identical fans, measured by pulse counting and by edge period respectively
+SimulatedFan CountingPlant(7, 6);
+SimulatedFan PeriodPlant(9, 8);
+void countingISR();
+void periodISR();
+FourWireFanSettings CountingSettings(7, 6, &countingISR);
+FourWireFanSettings PeriodSettings(9, 8, &periodISR, FALLING, INPUT_PULLUP, 1000L, FOURWIREFAN_PERIOD);
+FourWireFan* Counting;
+FourWireFan* Period;
+void countingISR() { Counting->count(); }
+void periodISR() { Period->count(); }
+
+// shows whether a value is within a tolerance of the actual one (in rpm, or % of it)
+bool within(float value, float actual, float tolerance, bool percent = false) {
+    return fabs(value - actual) <= (percent ? tolerance * actual / 100 : tolerance);
+}
+
+bool spinup() {
+    Serial.println("Spin-up (break away at 30%, set point 20%):");
+
+    Sticky = new FourWireFan(&StickySettings, &StickyModel);
+    Sticky->setPWM(20);
+
+    unsigned long done = 0;                         // the end of the first spin-up (in ms)
+    uint8_t spinups = 0;
+
+    for (uint8_t i = 0; i < 60; i++) {
+        bool blocked = Sticky->isBlocked();
+
+        delay(period);
+        Sticky->update(period);
+
+        if (blocked != Sticky->isBlocked()) {
+            spinups += blocked ? 0 : 1;             // (started)
+            done = (blocked && !done) ? millis() : done; // (done)
+        }
+
+        if (0 == i % 4) {
+            Serial.println("  " + String(millis()) + " ms: " + String(StickyPlant.getDuty(), 0) + "% applied, "
+                + String(StickyPlant.getRPM(), 0) + " rpm actual, " + String(Sticky->getRPM()) + " rpm measured"
+                + (Sticky->isBlocked() ? " (spinning up)" : ""));
+        }
+    }
+
+    // a single spin-up of about the model's spin-up time, no false one at 20% (where a pulse is 300 rpm, i.e. a coarse reading)
+    bool passed = (1 == spinups) && (done >= StickyModel.spinup) && (done <= StickyModel.spinup + 5 * period);
+    passed = passed && within(StickyPlant.getDuty(), 20, 0.5) && within(Sticky->getRPM(), StickyPlant.getRPM(), 300);
+
+    Serial.println("  " + String(spinups) + " spin-up(s), done after " + String(done) + " ms" + (passed ? "" : " FAILED"));
+
+    return passed;
+}
+
+bool stall() {
+    Serial.println("Stall recovery (minimum speed 240 rpm, one pulse 300 rpm, rotor blocked for 1 s at 50%):");
+
+    Stalled = new FourWireFan(&StalledSettings, &StalledModel);
+    Stalled->setPWM(50)->update(period);
+    StalledPlant.setRPM(StalledPlant.getTarget());
+
+    unsigned long start = millis(), kicked = 0, running = 0;
+
+    for (uint8_t i = 0; i < 60; i++) {
+        StalledPlant.blocked = (i < 10);
+
+        delay(period);
+        Stalled->update(period);
+
+        kicked = (!kicked && Stalled->isBlocked()) ? millis() - start : kicked;
+        running = (kicked && !running && !Stalled->isBlocked()) ? millis() - start : running;
+    }
+
+    // spun up while blocked, and back at speed once released
+    bool passed = kicked && (kicked <= 1000) && running && within(Stalled->getRPM(), StalledPlant.getRPM(), 300);
+
+    Serial.println("  spin-up after " + String(kicked) + " ms, done after " + String(running) + " ms, " + String(StalledPlant.getRPM(), 0)
+        + " rpm actual, " + String(Stalled->getRPM()) + " rpm measured" + (passed ? "" : " FAILED"));
+
+    return passed;
+}
+
+bool debounce() {
+    Serial.println("Debouncing (3 bounces per tach edge, tau = 1000 us, 1000 ms periods):");
+
+    BouncyPlant.bounce = 3;
+
+    Bouncy = new FourWireFan(&BouncySettings);
+    Bouncy->setPWM(56)->update(period);
+    BouncyPlant.setRPM(BouncyPlant.getTarget());
+
+    uint32_t before = BouncyPlant.getPulses(), counted = 0;
+
+    for (uint8_t i = 0; i < 5; i++) {
+        delay(1000);
+        Bouncy->update(1000);
+        counted += Bouncy->getPulses();
+    }
+
+    uint32_t pulses = BouncyPlant.getPulses() - before;
+    bool passed = (counted + 1 >= pulses) && (counted <= pulses + 1) && within(Bouncy->getRPM(), BouncyPlant.getRPM(), 30); // (one pulse)
+
+    Serial.println("  " + String(BouncyPlant.getRPM(), 0) + " rpm actual, " + String(Bouncy->getRPM()) + " rpm measured, "
+        + String(counted) + " of " + String(pulses) + " pulses counted" + (passed ? "" : " FAILED"));
+
+    return passed;
+}
+
+// time from a set point step until the measured speed stays within 5% of the actual speed
+unsigned long settle(FourWireFan* fan, SimulatedFan* plant, unsigned long window) {
+    unsigned long start = millis();
+    unsigned long settled = 0;
+
+    fan->setPWM(80);
+
+    while (millis() - start < 5000) {
+        delay(window);
+        fan->update(window);
+
+        if (fabs(fan->getRPM() - plant->getRPM()) > 0.05f * plant->getRPM()) {
+            settled = millis() - start;
+        }
+    }
+
+    return settled;
+}
+
+bool latency() {
+    Serial.println("Measurement latency (step from 40% to 80%, until within 5%):");
+
+    Counting = new FourWireFan(&CountingSettings);
+    Period = new FourWireFan(&PeriodSettings);
+
+    Counting->setPWM(40)->update(period);
+    Period->setPWM(40)->update(period);
+    CountingPlant.setRPM(CountingPlant.getTarget());
+    PeriodPlant.setRPM(PeriodPlant.getTarget());
+    delay(2000);
+
+    unsigned long counting = settle(Counting, &CountingPlant, 1000);
+    unsigned long edges = settle(Period, &PeriodPlant, 100);
+    bool passed = (counting <= 3000) && (edges <= 500); // (the rotor itself takes a while)
+
+    Serial.println("  counting at 1000 ms: " + String(counting) + " ms");
+    Serial.println("  period at 100 ms: " + String(edges) + " ms" + (passed ? "" : " FAILED"));
+
+    return passed;
+}
+
+// a fan whose loop is delayed by other (simulated) work
+SimulatedFan BusyPlant(11, 10);
+void busyISR();
+FourWireFanSettings BusySettings(11, 10, &busyISR);
+FourWireFan* Busy;
+void busyISR() { Busy->count(); }
+
+bool jitter() {
+    Serial.println("Loop jitter (1000 ms period, up to 300 ms of other work per loop):");
+
+    Busy = new FourWireFan(&BusySettings);
+    Busy->setPWM(60)->update(period);
+    BusyPlant.setRPM(BusyPlant.getTarget());
+
+    float trusted = 0.0f, measured = 0.0f;
+
+    for (uint8_t i = 0; i < 10; i++) {              // trusting the caller's duration…
+        delay(1000 + rand() % 300);
+        Busy->update(1000);
+        trusted = max(trusted, fabs(Busy->getRPM() - BusyPlant.getRPM()));
+    }
+
+    for (uint8_t i = 0; i < 10; ) {                 // …vs. polling with measured periods
+        delay(rand() % 300);
+        if (Busy->poll(1000)) {
+            measured = max(measured, fabs(Busy->getRPM() - BusyPlant.getRPM()));
+            i++;
+        }
+    }
+
+    bool passed = (measured <= 60) && (measured < trusted); // (two pulses)
+
+    Serial.println("  update(1000): max. error " + String(trusted, 0) + " rpm, poll(1000): max. error " + String(measured, 0) + " rpm"
+        + (passed ? "" : " FAILED"));
+
+    return passed;
+}
+
+// a fan counted by Timer1 (tach connected to T1) instead of an external interrupt
+SimulatedFan CountedPlant(13, FOURWIREFAN_T1_PIN);
+FourWireFanTimerTach TimerTach;
+FourWireFanSettings CountedSettings(13, FOURWIREFAN_T1_PIN, nullptr, FALLING, INPUT_PULLUP, 0, FOURWIREFAN_COUNTING, &TimerTach);
+FourWireFan* Counted;
+
+bool hardware() {
+    Serial.println("Hardware counter (Timer1 clocked by T1):");
+
+    Counted = new FourWireFan(&CountedSettings);
+    Counted->setPWM(70)->update(period);
+    CountedPlant.setRPM(CountedPlant.getTarget());
+
+    uint32_t before = CountedPlant.getPulses(), counted = 0;
+
+    for (uint8_t i = 0; i < 10; i++) {
+        delay(1000);
+        Counted->update(1000);
+        counted += Counted->getRPM() * 2 / 60;
+    }
+
+    uint32_t pulses = CountedPlant.getPulses() - before;
+    bool passed = (counted + 1 >= pulses) && (counted <= pulses + 1) && within(Counted->getRPM(), CountedPlant.getRPM(), 30);
+
+    Serial.println("  " + String(CountedPlant.getRPM(), 0) + " rpm actual, " + String(Counted->getRPM()) + " rpm measured, "
+        + String(counted) + " of " + String(pulses) + " pulses counted" + (passed ? "" : " FAILED"));
+
+    return passed;
+}
+
+// a slow case fan with glitches on its tach line and a fast server fan, each measured with a fixed and with an adaptive filter
+FourWireFanModel CaseModel(20, 400, 100, 1200);
+FourWireFanModel ServerModel(20, 1000, 100, 6000);
+SimulatedFan CasePlants[2] = {SimulatedFan(17, 18, 1200), SimulatedFan(19, 20, 1200)};
+SimulatedFan ServerPlants[2] = {SimulatedFan(21, 22, 6000), SimulatedFan(23, 24, 6000)};
+void caseFixedISR(); void caseAdaptiveISR(); void serverFixedISR(); void serverAdaptiveISR();
+FourWireFanSettings FilterSettings[4] = {
+    FourWireFanSettings(17, 18, &caseFixedISR),
+    FourWireFanSettings(19, 20, &caseAdaptiveISR, FALLING, INPUT_PULLUP, 10000L, FOURWIREFAN_COUNTING, nullptr, FOURWIREFAN_ANALOGWRITE, FOURWIREFAN_ADAPTIVE),
+    FourWireFanSettings(21, 22, &serverFixedISR),
+    FourWireFanSettings(23, 24, &serverAdaptiveISR, FALLING, INPUT_PULLUP, 10000L, FOURWIREFAN_COUNTING, nullptr, FOURWIREFAN_ANALOGWRITE, FOURWIREFAN_ADAPTIVE)
+};
+FourWireFan* Filtered[4];
+void caseFixedISR() { Filtered[0]->count(); }
+void caseAdaptiveISR() { Filtered[1]->count(); }
+void serverFixedISR() { Filtered[2]->count(); }
+void serverAdaptiveISR() { Filtered[3]->count(); }
+
+bool filter() {
+    Serial.println("Filters (default tau = 10000 us vs. adaptive, case fan with 10 glitches/s):");
+
+    for (uint8_t i = 0; i < 4; i++) {
+        SimulatedFan* plant = (i < 2) ? &CasePlants[i] : &ServerPlants[i - 2];
+        plant->noise = (i < 2) ? 10 : 0;
+        Filtered[i] = new FourWireFan(&FilterSettings[i], (i < 2) ? &CaseModel : &ServerModel);
+        Filtered[i]->setPWM((i < 2) ? 30 : 100)->update(period);
+        plant->setRPM(plant->getTarget());
+    }
+
+    uint32_t glitches[4] = {0, 0, 0, 0};
+    float errors[4] = {0, 0, 0, 0};               // (mean absolute error, in rpm)
+    for (uint8_t n = 0; n < 10; n++) {
+        delay(1000);
+        for (uint8_t i = 0; i < 4; i++) {
+            SimulatedFan* plant = (i < 2) ? &CasePlants[i] : &ServerPlants[i - 2];
+            Filtered[i]->update(1000);
+            glitches[i] += Filtered[i]->getGlitches();
+            errors[i] += fabs(Filtered[i]->getRPM() - plant->getRPM()) / 10;
+        }
+    }
+
+    for (uint8_t i = 0; i < 4; i++) {
+        SimulatedFan* plant = (i < 2) ? &CasePlants[i] : &ServerPlants[i - 2];
+        Serial.println("  " + String((i < 2) ? "case" : "server") + ((i % 2) ? " (adaptive): " : " (fixed): ") + String(plant->getRPM(), 0)
+            + " rpm actual, " + String(Filtered[i]->getRPM()) + " rpm measured (" + String(errors[i], 0) + " rpm off on average), "
+            + String(glitches[i]) + " edges rejected");
+    }
+
+    // on average, the adaptive filter reads both fans within about a pulse (30 rpm), the fixed one is off by 10% at either end
+    bool passed = (errors[1] <= 30) && (errors[3] <= 30);
+    passed = passed && (errors[0] > CasePlants[0].getRPM() / 10) && (errors[2] > ServerPlants[0].getRPM() / 10);
+
+    if (!passed) {
+        Serial.println("  FAILED");
+    }
+
+    return passed;
+}
+
+// a server fan with a light rotor (i.e. a fast step) and glitches on its tach line, started from standstill with the adaptive filter
+SimulatedFan StartedPlant(27, 28, 6000, 50);
+void startedISR();
+FourWireFanSettings StartedSettings(27, 28, &startedISR, FALLING, INPUT_PULLUP, 10000L, FOURWIREFAN_COUNTING, nullptr, FOURWIREFAN_ANALOGWRITE, FOURWIREFAN_ADAPTIVE);
+FourWireFan* Started;
+void startedISR() { Started->count(); }
+
+bool relock() {
+    Serial.println("Adaptive filter after a fast step (light server fan from standstill to 100% within 50 ms, 100 glitches/s):");
+
+    StartedPlant.noise = 100;
+    Started = new FourWireFan(&StartedSettings, &ServerModel);
+    Started->setPWM(100);
+
+    float error = 0;                                // (mean absolute error over the last second, in rpm)
+
+    for (uint8_t i = 0; i < 50; i++) {
+        delay(period);
+        Started->update(period);
+        error += (i >= 40) ? fabs(Started->getRPM() - StartedPlant.getRPM()) / 10 : 0;
+    }
+
+    // the tracked period follows the rotor instead of locking onto a multiple of its pulse period (one pulse is 300 rpm here)
+    bool passed = (error <= StartedPlant.getRPM() / 10);
+
+    Serial.println("  " + String(StartedPlant.getRPM(), 0) + " rpm actual, " + String(Started->getRPM()) + " rpm measured (" + String(error, 0)
+        + " rpm off on average after 4 s)" + (passed ? "" : " FAILED"));
+
+    return passed;
+}
+
+// a fan driven by Timer3 at 25 kHz (OC3A) instead of `analogWrite()`
+SimulatedFan TimedPlant(5, 14);
+void timedISR();
+FourWireFanSettings TimedSettings(5, 14, &timedISR, FALLING, INPUT_PULLUP, 10000L, FOURWIREFAN_COUNTING, nullptr, FOURWIREFAN_25KHZ);
+FourWireFan* Timed;
+void timedISR() { Timed->count(); }
+
+bool output() {
+    Serial.println("PWM output (Timer3 at 25 kHz):");
+
+    Timed = new FourWireFan(&TimedSettings);
+    Timed->setPWM(37)->update(period);
+
+    Serial.println("  " + String(F_CPU / 2 / ICR3) + " Hz, 37% set: OCR3A = " + String(OCR3A) + " of " + String(ICR3)
+        + " (" + String(TimedPlant.getDuty(), 2) + "% applied)");
+
+    uint16_t ocr = OCR3A;
+
+    Timed->setDuty(Timed->getDuty() + 0xFFFF / ICR3)->update(period);
+
+    bool passed = (25000 == F_CPU / 2 / ICR3) && (118 == ocr) && (119 == OCR3A) && (37 == Timed->getPWM()); // (37% of 320 is 118.4)
+
+    Serial.println("  one step up: OCR3A = " + String(OCR3A) + " (" + String(TimedPlant.getDuty(), 2) + "% applied, "
+        + String(Timed->getPWM()) + "% reported)" + (passed ? "" : " FAILED"));
+
+    return passed;
+}
+
+// a fan with jittery tach edges, read out in batches by a slow telemetry task
+SimulatedFan TrendedPlant(15, 16);
+void trendedISR();
+FourWireFanSettings TrendedSettings(15, 16, &trendedISR, FALLING, INPUT_PULLUP, 1000L, FOURWIREFAN_PERIOD);
+FourWireFan* Trended;
+void trendedISR() { Trended->count(); }
+
+bool history() {
+    Serial.println("History (10 Hz updates, telemetry reads up to 4 records every 500 ms):");
+
+    TrendedPlant.jitter = 10;
+    Trended = new FourWireFan(&TrendedSettings);
+    Trended->setPWM(50)->update(period);
+    TrendedPlant.setRPM(TrendedPlant.getTarget());
+    Trended->getHistory()->clear();
+    Trended->getHistory()->restart();
+
+    FourWireFanRecord records[4];
+    uint32_t read = 0, dropped = 0, sum = 0;
+
+    for (uint8_t i = 0; i < 50; i++) {
+        delay(period);
+        Trended->update(period);
+
+        if (4 == i % 5) {
+            uint8_t n = Trended->getHistory()->read(records, 4);
+            for (uint8_t r = 0; r < n; r++) {
+                sum += records[r].rpm;
+            }
+            read += n;
+            dropped += Trended->getHistory()->getDropped();
+        }
+    }
+
+    FourWireFanStatistics stats;
+    Trended->getHistory()->getStatistics(&stats);
+
+    Serial.println("  " + String(read) + " records read (mean " + String(sum / max(read, 1UL)) + " rpm), "
+        + String(Trended->getHistory()->available()) + " unread, " + String(dropped) + " dropped");
+    Serial.println("  " + String(stats.count) + " updates: " + String(stats.min) + " .. " + String(stats.max) + " rpm, mean "
+        + String(stats.mean) + " rpm, std. dev. " + String(sqrt(stats.variance), 0) + " rpm (" + String(TrendedPlant.getRPM(), 0) + " rpm actual)");
+
+    // every update is either read, unread or dropped, and the statistics match the actual speed
+    bool passed = (50 == read + Trended->getHistory()->available() + dropped) && (50 == stats.count);
+    passed = passed && within(stats.mean, TrendedPlant.getRPM(), 5, true) && (stats.min <= stats.mean) && (stats.mean <= stats.max);
+
+    if (!passed) {
+        Serial.println("  FAILED");
+    }
+
+    return passed;
+}
+
+void setup() {
+    Serial.begin(115200);
+
+    bool passed = spinup();
+    passed = stall() && passed;
+    passed = debounce() && passed;
+    passed = latency() && passed;
+    passed = jitter() && passed;
+    passed = hardware() && passed;
+    passed = filter() && passed;
+    passed = relock() && passed;
+    passed = output() && passed;
+    passed = history() && passed;
+
+    Simulation::stop(passed ? 0 : 1);
+}
+
+void loop() {
+    // all scenarios run from setup()
+}
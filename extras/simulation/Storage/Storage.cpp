@@ -0,0 +1,155 @@
+/**
+ * Calibrates four simulated fans, stores their models in the (file backed) EEPROM, and restores them after a simulated reset.
+ *
+ * Build and run natively (no hardware required): `pio run -e native_storage -t exec`
+ */
+
+#include <stdio.h>
+#include "Arduino.h"
+#include <EEPROM.h>
+#include <FourWireFanArray.h>        // https://github.com/sekdiy/FourWireFan
+#include <FourWireFanCalibration.h>
+#include <FourWireFanStorage.h>
+#include "SimulatedFan.h"
+
+// update period (in ms, i.e. 10 Hz)
+const unsigned long period = 100;
+
+// the backing file of the simulated EEPROM
+const char* file = "storage.bin";
+
+// four different fans, each with a model of its own (i.e. generic until calibrated)
+uint16_t actualRPM[10] = {310, 520, 760, 980, 1170, 1340, 1490, 1610, 1720, 1810};
+FourWireFanSettings Settings(3, 2, nullptr, FALLING, INPUT_PULLUP, 1000L, FOURWIREFAN_PERIOD);
+FourWireFanModel Models[4];
+FourWireFanModel Calibrated[4];
+FourWireFanArray<4> Fans;
+FourWireFanStorage Storage;
+uint16_t curves[4][10];
+
+// restores all fans from storage, returns the number of valid records
+uint8_t boot() {
+    uint8_t restored = 0;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        Models[i] = FourWireFanModel();             // as after a reset
+        Fans[i]->setModel(&Models[i]);
+        restored += Storage.load(i, Fans[i]) ? 1 : 0;
+    }
+
+    return restored;
+}
+
+// shows whether a fan's model matches its calibration
+bool same(uint8_t i) {
+    FourWireFanModel* model = Fans[i]->getModel();
+
+    return (model->minPWM == Calibrated[i].minPWM) && (model->minRPM == Calibrated[i].minRPM) && (model->maxRPM == Calibrated[i].maxRPM)
+        && (model->spinup == Calibrated[i].spinup) && !memcmp(model->refRPM, Calibrated[i].refRPM, sizeof(model->refRPM))
+        && (Fans[i]->getDebounceTime() == 800UL + 100 * i);
+}
+
+void setup() {
+    Serial.begin(115200);
+
+    remove(file);                                   // start with a blank EEPROM
+    EEPROM.attach(file);
+
+    Fans.add<16, 24>(&Models[0], Settings);
+    Fans.add<17, 25>(&Models[1], Settings);
+    Fans.add<18, 26>(&Models[2], Settings);
+    Fans.add<19, 27>(&Models[3], Settings);
+
+    FourWireFanCalibration* calibrations[4];
+
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t k = 0; k < 10; k++) {
+            curves[i][k] = actualRPM[k] * (10 - i) / 10;    // each fan a bit slower than the previous one
+        }
+
+        SimulatedFan* plant = new SimulatedFan(16 + i, 24 + i, curves[i][9], 600);
+        plant->refRPM = curves[i];
+        plant->stallPWM = 12 + i;
+        plant->startPWM = 25;
+        plant->minRPM = curves[i][0];
+
+        Fans[i]->setDebounceTime(800 + 100 * i);    // (tuned per fan)
+        calibrations[i] = new FourWireFanCalibration(Fans[i]);
+    }
+
+    /* first boot: nothing stored yet, so calibrate */
+    Serial.println("First boot: " + String(boot()) + " of 4 fans restored");
+
+    unsigned long start = millis();
+    bool running = true;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        calibrations[i]->begin(&Models[i]);
+    }
+
+    while (running) {
+        delay(period);
+        Fans.update(period);
+
+        running = false;
+        for (uint8_t i = 0; i < 4; i++) {
+            running = calibrations[i]->update() || running;
+        }
+    }
+
+    uint16_t written = 0;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        Calibrated[i] = Models[i];
+        written += Storage.save(i, Fans[i]);
+    }
+
+    Serial.println("  calibrated in " + String((millis() - start) / 1000) + " s, " + String(written) + " bytes written ("
+        + String(FOURWIREFAN_RECORD_SIZE) + " per record, " + String(Storage.getSlots()) + " slots in 1 KB)");
+
+    /* second boot: restored right away */
+    EEPROM.attach(file);                            // reset (rereads the file)
+
+    uint8_t restored = boot();
+    uint8_t matching = 0;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        matching += same(i) ? 1 : 0;
+    }
+
+    Serial.println("Second boot: " + String(restored) + " of 4 fans restored, " + String(matching) + " identical to their calibration");
+
+    uint32_t writes = EEPROM.getWrites();
+
+    for (uint8_t i = 0; i < 4; i++) {
+        Storage.save(i, Fans[i]);
+    }
+
+    writes = EEPROM.getWrites() - writes;
+
+    Serial.println("  saving again: " + String(writes) + " bytes written");
+
+    Fans[1]->getModel()->refRPM[5] += 10;
+    Fans[1]->setDebounceTime(1500);
+
+    Serial.println("  saving after tuning one fan: " + String(Storage.save(1, Fans[1])) + " bytes written");
+
+    /* third boot: one record damaged */
+    EEPROM.write(2 * FOURWIREFAN_RECORD_SIZE + 14, EEPROM.read(2 * FOURWIREFAN_RECORD_SIZE + 14) ^ 0x04); // a flipped bit in fan 2's curve
+    EEPROM.attach(file);
+
+    restored = boot();
+
+    Serial.println("Third boot (a bit flipped in fan 2's record): " + String(restored) + " of 4 fans restored, fan 2 "
+        + (same(2) ? String("restored anyway") : String("falls back to its default model")));
+
+    bool passed = (3 == restored) && (4 == matching) && (0 == writes) && !same(2) && (1500 == Fans[1]->getDebounceTime());
+
+    remove(file);
+
+    Simulation::stop(passed ? 0 : 1);
+}
+
+void loop() {
+    // all scenarios run from setup()
+}
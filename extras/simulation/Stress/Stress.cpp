@@ -0,0 +1,92 @@
+/**
+ * Fires tach edges at high rates against the measurement core and checks that every edge is counted exactly once.
+ *
+ * Updates happen at random moments, each critical section takes a few µs (so edges arrive within them, too),
+ * and bouncing edges must be debounced without losing the actual ones. The exit status is the number of failed runs.
+ *
+ * Build and run natively (no hardware required): `pio run -e native_stress -t exec`
+ */
+
+#include "Arduino.h"
+#include <FourWireFan.h>   // https://github.com/sekdiy/FourWireFan
+
+const uint8_t tachPin = 2;
+
+void tachISR();
+FourWireFanSettings Settings(3, tachPin, &tachISR, FALLING, INPUT_PULLUP, 0);
+FourWireFan* Fan;
+void tachISR() { Fan->count(); }
+
+uint8_t failed = 0;
+
+// random number within [lo, hi]
+uint32_t random(uint32_t lo, uint32_t hi) {
+    return lo + (uint32_t) rand() % (hi - lo + 1);
+}
+
+// schedules `edges` falling tach edges, `gap` µs apart (± `spread`), each followed by `bounces` bounces within `bounceTime` µs
+void fire(uint32_t edges, uint32_t gap, uint32_t spread, uint8_t bounces, uint32_t bounceTime) {
+    uint64_t at = Simulation::now + gap;
+
+    for (uint32_t i = 0; i < edges; i++) {
+        Simulation::edge(tachPin, LOW, at);
+
+        for (uint8_t b = 1; b <= bounces; b++) {
+            uint64_t t = at + bounceTime * b / (bounces + 1);
+            Simulation::edge(tachPin, HIGH, t);
+            Simulation::edge(tachPin, LOW, t + 1);
+        }
+
+        Simulation::edge(tachPin, HIGH, at + max(gap / 2, bounceTime + 1));
+        at += random(gap - spread, gap + spread);
+    }
+}
+
+// runs a single stress test: fires the edges and sums up the pulses of randomly timed updates
+void run(const char* name, uint32_t edges, uint32_t gap, uint32_t spread, uint8_t bounces, uint32_t bounceTime, uint32_t tau) {
+    Fan->setDebounceTime(tau);
+    Fan->update(FOURWIREFAN_ELAPSED);
+    Fan->reset();
+
+    uint64_t end = Simulation::now + (uint64_t) edges * (gap + spread) + 2 * gap + 1000;
+    uint32_t counted = 0, updates = 0;
+
+    fire(edges, gap, spread, bounces, bounceTime);
+
+    while (Simulation::now < end) {
+        delayMicroseconds(random(1, 3 * gap));      // the moment of sampling relative to the edges is random
+        Fan->update(FOURWIREFAN_ELAPSED);
+        counted += Fan->getPulses();
+        updates++;
+    }
+
+    bool passed = (counted == edges);
+    failed += !passed;
+
+    Serial.println("  " + String(name) + ": " + String(counted) + " of " + String(edges) + " edges counted in " + String(updates)
+        + " updates" + (passed ? "" : " (FAILED)"));
+}
+
+void setup() {
+    Serial.begin(115200);
+
+    Simulation::loopTime = 0;
+    Simulation::critical = 8;                       // e.g. `update()` on a 16 MHz AVR (interrupts disabled for some 100 cycles)
+
+    Fan = new FourWireFan(&Settings);
+
+    Serial.println("Clean edges (no debouncing, 8 us critical sections):");
+    run("1 kHz", 20000, 1000, 100, 0, 0, 0);
+    run("10 kHz", 20000, 100, 10, 0, 0, 0);
+    run("50 kHz", 20000, 20, 2, 0, 0, 0);
+
+    Serial.println("Bouncing edges (3 bounces within 200 us, 500 us debounce timeout):");
+    run("200 Hz", 5000, 5000, 500, 3, 200, 500);
+    run("1 kHz", 5000, 1000, 100, 3, 200, 500);
+
+    Simulation::stop(failed);
+}
+
+void loop() {
+    // all stress tests run from setup()
+}
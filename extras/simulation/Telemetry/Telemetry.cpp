@@ -0,0 +1,187 @@
+/**
+ * Streams eight simulated fans at 50 Hz over a simulated 115200 baud link, takes commands, and records the stream. Fails unless
+ * no frame is dropped and each command is carried out (or refused) and acknowledged as it should be.
+ *
+ * Build and run natively (no hardware required): `pio run -e native_telemetry -t exec`
+ * Then decode the recording on the host: `python3 extras/telemetry/telemetry.py .pio/telemetry.bin`
+ */
+
+#include <stdio.h>
+#include <deque>
+#include <vector>
+#include "Arduino.h"
+#include <FourWireFanArray.h>        // https://github.com/sekdiy/FourWireFan
+#include <FourWireFanTelemetry.h>
+#include "SimulatedFan.h"
+
+// update period (in ms, i.e. 50 Hz)
+const unsigned long period = 20;
+
+// the recording (within PlatformIO's build directory, relative to the project)
+#ifndef TELEMETRY_RECORDING
+#define TELEMETRY_RECORDING ".pio/telemetry.bin"
+#endif
+
+// a serial link at 115200 baud (8N1) with a 64 byte transmit FIFO, recording whatever is sent (and noting the acknowledgements)
+class Link : public Stream {
+    public:
+        std::deque<uint8_t> rx;                 // bytes received from the host
+        FILE* file = nullptr;                   // the recording
+        uint32_t sent = 0;                      // the number of bytes sent
+        uint16_t fill = 0;                      // the number of bytes in the transmit FIFO
+        unsigned long drained = 0;              // the moment the FIFO has been drained up to (in µs)
+        std::vector<uint8_t> frame;             // the frame being sent (COBS encoded)
+        int16_t acks[8] = {-1, -1, -1, -1, -1, -1, -1, -1}; // the status acknowledged per command sequence number (-1: none)
+
+        int available() override { return this->rx.size(); }
+        int read() override { uint8_t c = this->rx.front(); this->rx.pop_front(); return c; }
+        size_t write(uint8_t c) override { return this->write(&c, 1); }
+
+        int availableForWrite() override {
+            unsigned long now = micros();
+            uint16_t out = (now - this->drained) / 87; // 10 bits at 115200 baud take 87 µs
+
+            this->drained += out * 87UL;
+            this->fill -= min(out, this->fill);
+
+            if (0 == this->fill) {
+                this->drained = now;
+            }
+
+            return 64 - this->fill;
+        }
+
+        size_t write(const uint8_t* buffer, size_t size) override {
+            size = min(size, (size_t) this->availableForWrite());
+            fwrite(buffer, 1, size, this->file);
+            this->fill += size;
+            this->sent += size;
+
+            for (size_t i = 0; i < size; i++) {
+                if (buffer[i]) {
+                    this->frame.push_back(buffer[i]);
+                } else {
+                    this->receive();
+                    this->frame.clear();
+                }
+            }
+
+            return size;
+        }
+
+        void receive() {                        // decodes a complete frame (as the host would), notes an acknowledgement
+            std::vector<uint8_t> data;
+
+            for (size_t i = 0; i < this->frame.size(); ) {
+                uint8_t code = this->frame[i++];
+                for (uint8_t k = 1; (k < code) && (i < this->frame.size()); k++) {
+                    data.push_back(this->frame[i++]);
+                }
+                if ((code < 0xFF) && (i < this->frame.size())) {
+                    data.push_back(0);
+                }
+            }
+
+            if ((6 == data.size()) && (FOURWIREFAN_FRAME_ACK == data[0]) && (data[1] < 8)
+                && (FourWireFan::crc16(data.data(), 4) == (data[4] | (uint16_t) data[5] << 8))) {
+                this->acks[data[1]] = data[3];
+            }
+        }
+};
+
+Link Host;
+
+// commands from the host (see `telemetry.py --encode`): fan 3 to 80%, fan 5 to 1200 rpm, fan 9 (which doesn't exist) and fan 2
+// (a short frame, i.e. without the pwm value)
+const uint8_t setPWM[] = {0x07, 0x10, 0x01, 0x03, 0x50, 0xf1, 0xa7, 0x00};
+const uint8_t setRPM[] = {0x08, 0x11, 0x02, 0x05, 0xb0, 0x04, 0x16, 0xe7, 0x00};
+const uint8_t setUnknown[] = {0x07, 0x10, 0x03, 0x09, 0x32, 0xbe, 0x6a, 0x00};
+const uint8_t setShort[] = {0x06, 0x10, 0x04, 0x02, 0x79, 0x63, 0x00};
+
+FourWireFanSettings Settings(3, 2, nullptr, FALLING, INPUT_PULLUP, 1000L, FOURWIREFAN_PERIOD);
+FourWireFanArray<8> Fans;
+FourWireFanTelemetry Telemetry(&Host);
+
+void setup() {
+    Serial.begin(115200);
+
+    Host.file = fopen(TELEMETRY_RECORDING, "wb");
+
+    if (!Host.file) {
+        Serial.println("Can't record to " TELEMETRY_RECORDING);
+        Simulation::stop(1);
+        return;
+    }
+
+    Fans.add<16, 24>(&NF_A12_25_FanModel, Settings);
+    Fans.add<17, 25>(&NF_A12_25_FanModel, Settings);
+    Fans.add<18, 26>(&NF_A12_25_FanModel, Settings);
+    Fans.add<19, 27>(&NF_A12_25_FanModel, Settings);
+    Fans.add<20, 28>(&NF_A12_25_FanModel, Settings);
+    Fans.add<21, 29>(&NF_A12_25_FanModel, Settings);
+    Fans.add<22, 30>(&NF_A12_25_FanModel, Settings);
+    Fans.add<23, 31>(&NF_A12_25_FanModel, Settings);
+
+    for (uint8_t i = 0; i < 8; i++) {
+        SimulatedFan* plant = new SimulatedFan(16 + i, 24 + i, 1700, 400);
+        plant->setRPM(1000);
+        Fans[i]->setPWM(30 + 5 * i);
+        Telemetry.add(Fans[i]);
+    }
+
+    Fans.reset();
+
+    uint16_t pending = 0;
+    uint16_t dropped = 0;
+
+    for (unsigned long tick = 1; tick <= 500; tick++) {     // 10 s
+        if (100 == tick) Host.rx.insert(Host.rx.end(), setPWM, setPWM + sizeof(setPWM));
+        if (200 == tick) Host.rx.insert(Host.rx.end(), setRPM, setRPM + sizeof(setRPM));
+        if (300 == tick) Host.rx.insert(Host.rx.end(), setUnknown, setUnknown + sizeof(setUnknown));
+        if (400 == tick) Host.rx.insert(Host.rx.end(), setShort, setShort + sizeof(setShort));
+
+        unsigned long start = micros();
+
+        while (micros() - start < period * 1000UL) {        // the control loop, meanwhile sending in the background
+            Telemetry.poll();
+            pending = max(pending, Telemetry.getPending());
+            delayMicroseconds(500);
+        }
+
+        Fans.update(period);
+
+        Telemetry.send();
+        dropped += Telemetry.getDropped();
+    }
+
+    fclose(Host.file);
+
+    /* the equivalent text report, for comparison */
+    String text = "";
+    for (uint8_t i = 0; i < 8; i++) {
+        text += "Fan " + String(i) + ": " + String(Fans[i]->getRPM()) + " rpm (set point: " + String(Fans[i]->getPWM()) + "%)\n";
+    }
+
+    Serial.println("Telemetry (8 fans at 50 Hz, 115200 baud):");
+    Serial.println("  binary: " + String(Host.sent / 10) + " bytes/s (" + String(Host.sent / 10 * 100 / 11520) + "% of the link), "
+        + String(dropped) + " frames dropped, at most " + String(pending) + " bytes queued, never blocking");
+    Serial.println("  text: " + String(text.length() * 50) + " bytes/s (" + String(text.length() * 50 * 100 / 11520)
+        + "% of the link), i.e. " + String(text.length() * 87 / 1000) + " ms blocked per 20 ms update");
+    Serial.println("  commands: fan 3 at " + String(Fans[3]->getPWM()) + "%, fan 5 at " + String(Fans[5]->getPWM()) + "% (for 1200 rpm), fan 2 at " + String(Fans[2]->getPWM()) + "%, acknowledged with "
+        + String(Host.acks[1]) + ", " + String(Host.acks[2]) + ", " + String(Host.acks[3]) + ", " + String(Host.acks[4]));
+    Serial.println("  recorded to " TELEMETRY_RECORDING " (see extras/telemetry/telemetry.py)");
+
+    bool passed = (0 == dropped) && (80 == Fans[3]->getPWM()) && (NF_A12_25_FanModel.toPWM(1200) == Fans[5]->getPWM()) && (40 == Fans[2]->getPWM());
+    passed = passed && (FOURWIREFAN_OK == Host.acks[1]) && (FOURWIREFAN_OK == Host.acks[2]);
+    passed = passed && (FOURWIREFAN_UNKNOWN_FAN == Host.acks[3]) && (FOURWIREFAN_UNKNOWN_COMMAND == Host.acks[4]);
+
+    if (!passed) {
+        Serial.println("  FAILED");
+    }
+
+    Simulation::stop(passed ? 0 : 1);
+}
+
+void loop() {
+    // all scenarios run from setup()
+}
@@ -0,0 +1,145 @@
+/**
+ * Drives simulated fans from synthetic temperature traces via fan curves and reports the resulting duty cycles. Fails unless the
+ * CPU cooler follows the load burst to full duty, both fans ask for full duty while a sensor has failed, and hysteresis keeps the
+ * cooler's duty steadier than without, while idling.
+ *
+ * Build and run natively (no hardware required): `pio run -e native_thermal -t exec`
+ */
+
+#include "Arduino.h"
+#include <FourWireFan.h>             // https://github.com/sekdiy/FourWireFan
+#include <FourWireFanThermal.h>
+#include "SimulatedFan.h"
+
+// tick period (in ms, i.e. 2 Hz)
+const unsigned long period = 500;
+
+// the CPU zone: idling at 40 °C (±0.8 °C sensor noise), a load burst from 20 s to 50 s (up to 75 °C)
+int16_t cpu() {
+    float t = millis() / 1000.0f;
+    float load = (t < 20) ? 0.0f : (t < 50) ? 1.0f - expf(-(t - 20) / 8.0f) : (1.0f - expf(-30 / 8.0f)) * expf(-(t - 50) / 8.0f);
+
+    return (int16_t) (400 + 350 * load + 8 * sinf(t * 2.5f));
+}
+
+// the ambient zone: a slow ramp from 25 °C to 37 °C, with a sensor failure from 70 s to 75 s
+int16_t ambient() {
+    unsigned long t = millis() / 1000;
+
+    return ((70 <= t) && (t < 75)) ? FOURWIREFAN_NO_TEMPERATURE : (int16_t) (250 + t * 120 / 90);
+}
+
+// the curves (temperatures in 1/10 °C)
+FourWireFanCurve Cpu;
+FourWireFanCurve Case;
+
+// the fans: CPU cooler (maximum of both zones), case fan (weighted), and the CPU cooler once more, without hysteresis
+SimulatedFan CoolerPlant(3, 2), CasePlant(5, 4), PlainPlant(7, 6);
+
+void coolerISR(), caseISR(), plainISR();
+FourWireFanSettings CoolerSettings(3, 2, &coolerISR), CaseSettings(5, 4, &caseISR), PlainSettings(7, 6, &plainISR);
+FourWireFan* Cooler;
+FourWireFan* CaseFan;
+FourWireFan* Plain;
+void coolerISR() { Cooler->count(); }
+void caseISR() { CaseFan->count(); }
+void plainISR() { Plain->count(); }
+
+FourWireFanThermal Maximum(FOURWIREFAN_MAX);
+FourWireFanThermal Weighted(FOURWIREFAN_WEIGHTED);
+FourWireFanThermal Unfiltered(FOURWIREFAN_MAX, 0, 0);
+
+// right aligns a value within a column
+String column(String value, uint8_t width) {
+    while (value.length() < width) {
+        value = " " + value;
+    }
+    return value;
+}
+
+// formats a temperature (in 1/10 °C)
+String celsius(int16_t temperature) {
+    return column((FOURWIREFAN_NO_TEMPERATURE == temperature) ? String("n/a") : String(temperature / 10.0, 1) + " °C", 9);
+}
+
+// formats a duty cycle (in 1/65535)
+String percent(uint16_t duty) {
+    return column(String(duty * 100.0 / 65535, 1) + "%", 8);
+}
+
+void setup() {
+    Serial.begin(115200);
+
+    Cpu.add(400, 20)->add(550, 40)->add(700, 100);
+    Case.add(300, 20)->add(450, 60)->add(600, 100);
+
+    Cooler = new FourWireFan(&CoolerSettings);
+    CaseFan = new FourWireFan(&CaseSettings);
+    Plain = new FourWireFan(&PlainSettings);
+
+    uint8_t hot = Maximum.addZone(&cpu), cool = Maximum.addZone(&ambient);
+    Maximum.bind(hot, Cooler, &Cpu);
+    Maximum.bind(cool, Cooler, &Case);
+
+    Weighted.addZone(&cpu);
+    Weighted.addZone(&ambient);
+    Weighted.bind(0, CaseFan, &Case, 1);
+    Weighted.bind(1, CaseFan, &Case, 3);
+
+    Unfiltered.addZone(&cpu);
+    Unfiltered.bind(0, Plain, &Cpu, 1, 0);
+
+    Serial.println("Thermal engine (2 Hz ticks, curves with 2 °C hysteresis, 100%/s up and 10%/s down):");
+    Serial.println("   time      cpu  ambient  cooler (max)  case (weighted)");
+
+    uint16_t changes[2] = {0, 0};
+    uint16_t previous[2] = {0, 0};
+    uint16_t peak = 0;
+    bool failsafe = true;                          // (both fans asked for full duty while the ambient sensor failed)
+
+    for (unsigned long tick = 1; tick <= 180; tick++) {
+        delay(period);
+
+        Maximum.update();
+        Weighted.update();
+        Unfiltered.update();
+
+        Cooler->update(period);
+        CaseFan->update(period);
+        Plain->update(period);
+
+        peak = max(peak, Cooler->getApplied());
+
+        if (FOURWIREFAN_NO_TEMPERATURE == Maximum.getTemperature(1)) {
+            failsafe = failsafe && (0xFFFF == Cooler->getDuty()) && (0xFFFF == CaseFan->getDuty());
+        }
+
+        if ((10000 < millis()) && (millis() < 20000)) { // idle (and settled): sensor noise only
+            uint16_t duties[2] = {Cooler->getApplied(), Plain->getApplied()};
+            for (uint8_t i = 0; i < 2; i++) {
+                changes[i] += (duties[i] != previous[i]);
+                previous[i] = duties[i];
+            }
+        }
+
+        if (0 == tick % 10) {
+            Serial.println(column(String(millis() / 1000) + " s", 7) + celsius(Maximum.getTemperature(0)) + celsius(Maximum.getTemperature(1))
+                + column(percent(Cooler->getApplied()), 14) + column(percent(CaseFan->getApplied()), 17));
+        }
+    }
+
+    Serial.println("Duty changes while idling from 10 s to 20 s (sensor noise only): " + String(changes[0]) + " with hysteresis and rate limits, "
+        + String(changes[1]) + " without");
+
+    bool passed = (0xFFFF == peak) && failsafe && (changes[0] < changes[1]) && (changes[0] <= 2);
+
+    if (!passed) {
+        Serial.println("  FAILED (cooler at " + String(peak * 100.0 / 65535, 1) + "% at most, " + (failsafe ? "" : "not ") + "full duty on sensor failure)");
+    }
+
+    Simulation::stop(passed ? 0 : 1);
+}
+
+void loop() {
+    // all scenarios run from setup()
+}
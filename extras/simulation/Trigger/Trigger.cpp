@@ -0,0 +1,130 @@
+/**
+ * Compares event driven updates (after a number of tach edges) with fixed measuring periods, at low, medium and high speed.
+ *
+ * Build and run natively (no hardware required): `pio run -e native_trigger -t exec`
+ */
+
+#include <math.h>
+#include "Arduino.h"
+#include <FourWireFan.h>             // https://github.com/sekdiy/FourWireFan
+#include "SimulatedFan.h"
+
+// the fixed measuring period and the event driven one's timeout (in ms), and its trigger (in tach edge intervals)
+const uint16_t period = 100;
+const uint16_t timeout = 1000;
+const uint8_t edges = 8;
+
+// the speeds to compare at (in % of 3000 rpm, i.e. 300, 990 and 2610 rpm)
+const uint8_t speeds[] = {10, 33, 87};
+
+// a permissive model (no limits, no spin-up), two identical fans with jittery tach edges
+FourWireFanModel Model(0, 0, 100, 3000, 0);
+
+void fixedISR();
+void triggeredISR();
+FourWireFanSettings FixedSettings(3, 2, &fixedISR, FALLING, INPUT_PULLUP, 100L);
+FourWireFanSettings TriggeredSettings(5, 4, &triggeredISR, FALLING, INPUT_PULLUP, 100L);
+FourWireFan* Fixed;
+FourWireFan* Triggered;
+void fixedISR() { Fixed->count(); }
+void triggeredISR() { Triggered->count(); }
+
+// counts the callbacks (from the ISR)
+volatile uint32_t notified = 0;
+void onTrigger(FourWireFan*) { notified++; }
+
+// a fan's updates and the root mean square of their relative errors
+struct Result {
+    uint32_t updates = 0;
+    double squares = 0.0;
+
+    void add(uint32_t rpm, float truth) {
+        double error = (rpm - truth) / max(truth, 1.0f);
+        this->squares += error * error;
+        this->updates++;
+    }
+
+    uint32_t error() { return this->updates ? (uint32_t) (sqrt(this->squares / this->updates) * 1000) : 0; } // (in 1/10 %)
+    uint32_t latency(uint32_t ms) { return this->updates ? ms / this->updates : 0; }                        // (in ms)
+};
+
+// formats 1/10 % as percent
+String percent(uint32_t permille) {
+    return String(permille / 10) + "." + String(permille % 10) + "%";
+}
+
+void setup() {
+    Serial.begin(115200);
+
+    Fixed = new FourWireFan(&FixedSettings, &Model);
+    Triggered = new FourWireFan(&TriggeredSettings, &Model);
+    Triggered->setTrigger(edges, &onTrigger);
+
+    SimulatedFan* plants[2] = {new SimulatedFan(3, 2, 3000, 500), new SimulatedFan(5, 4, 3000, 500)};
+
+    for (uint8_t i = 0; i < 2; i++) {
+        plants[i]->minRPM = 0;
+        plants[i]->stallPWM = 0;
+        plants[i]->startPWM = 0;
+        plants[i]->jitter = 2;
+    }
+
+    bool passed = true;
+    uint32_t previous = 0xFFFFFFFFUL;
+
+    Serial.println("Every " + String(period) + " ms vs. every " + String(edges) + " tach edge intervals (timeout " + String(timeout) + " ms):");
+
+    for (uint8_t s = 0; s < sizeof(speeds); s++) {
+        Result fixed, triggered;
+        uint32_t callbacks = notified;
+
+        Fixed->setPWM(speeds[s]);
+        Triggered->setPWM(speeds[s]);
+
+        unsigned long start = millis();
+
+        while (millis() - start < 13000) {
+            delay(1);
+
+            bool measuring = (millis() - start >= 3000); // (after settling)
+
+            if (Fixed->poll(period) && measuring) {
+                fixed.add(Fixed->getRawRPM(), plants[0]->getRPM());
+            }
+            if (Triggered->poll(timeout) && measuring) {
+                triggered.add(Triggered->getRawRPM(), plants[1]->getRPM());
+            }
+        }
+
+        callbacks = notified - callbacks;
+
+        Serial.println("  " + String(plants[1]->getRPM(), 0) + " rpm: fixed " + percent(fixed.error()) + " off every " + String(fixed.latency(10000))
+            + " ms, triggered " + percent(triggered.error()) + " off every " + String(triggered.latency(10000)) + " ms (" + String(callbacks) + " callbacks)");
+
+        passed = passed && (triggered.error() < fixed.error());     // exact edge spans beat counting…
+        passed = passed && (triggered.error() < 20);                // …at any speed…
+        passed = passed && (triggered.latency(10000) < previous);   // …and the latency drops as the fan speeds up
+        previous = triggered.latency(10000);
+    }
+
+    /* standstill: the timeout applies */
+    Triggered->setPWM(0);
+
+    unsigned long stopped = millis();
+    uint32_t updates = 0;
+
+    while (millis() - stopped < 10000) {        // (coasting for the first 5 s)
+        delay(1);
+        updates += (Triggered->poll(timeout) && (millis() - stopped >= 5000)) ? 1 : 0;
+    }
+
+    Serial.println("  standstill: " + String(Triggered->getRawRPM()) + " rpm, " + String(updates) + " updates in 5 s");
+
+    passed = passed && (0 == Triggered->getRawRPM()) && (5 == updates);
+
+    Simulation::stop(passed ? 0 : 1);
+}
+
+void loop() {
+    // all scenarios run from setup()
+}
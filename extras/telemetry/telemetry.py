@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""
+Four Wire Fan
+
+Host side of the binary telemetry link (see `FourWireFanTelemetry`): decodes sample frames into CSV and sends commands.
+
+    python3 telemetry.py /dev/ttyACM0                       # log all fans (requires pyserial)
+    python3 telemetry.py /dev/ttyACM0 --set-pwm 2 60        # set fan 2 to 60%, then log
+    python3 telemetry.py telemetry.bin                      # decode a recording (or `-` for stdin)
+    python3 telemetry.py --encode --set-rpm 0 1200          # print the encoded command (e.g. for a simulation)
+
+@author sekdiy (https://github.com/sekdiy/FourWireFan)
+@date 16.10.2026 Initial release.
+@version See git comments for changes.
+"""
+
+import argparse
+import struct
+import sys
+
+FRAME_SAMPLE = 0x01
+FRAME_ACK = 0x02
+FRAME_SET_PWM = 0x10
+FRAME_SET_RPM = 0x11
+FRAME_SET_DUTY = 0x12
+
+HEALTH = ["healthy", "tach lost", "stalled", "overspeed", "degraded"]
+STATUS = ["ok", "unknown fan", "unknown command"]
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16 (CCITT, i.e. polynomial 0x1021, initially 0xFFFF), as `FourWireFan::crc16()`."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    """COBS encodes a frame (without the delimiter)."""
+    out = bytearray([0])
+    code = 0
+    for byte in data:
+        if byte:
+            out.append(byte)
+        if not byte or len(out) - code == 0xFF:
+            out[code] = len(out) - code
+            code = len(out)
+            out.append(0)
+    out[code] = len(out) - code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    """COBS decodes a frame (without the delimiter), returns None if it's truncated."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def frame(kind, sequence, payload):
+    """Builds a complete frame, i.e. type, sequence, payload and CRC, COBS encoded and delimited."""
+    raw = bytes([kind, sequence]) + payload
+    return cobs_encode(raw + struct.pack("<H", crc16(raw))) + b"\x00"
+
+
+def command(args, sequence):
+    """Builds the command frame requested on the command line (if any)."""
+    if args.set_pwm:
+        return frame(FRAME_SET_PWM, sequence, struct.pack("<BB", *args.set_pwm))
+    if args.set_rpm:
+        return frame(FRAME_SET_RPM, sequence, struct.pack("<BH", *args.set_rpm))
+    if args.set_duty:
+        return frame(FRAME_SET_DUTY, sequence, struct.pack("<BH", *args.set_duty))
+    return None
+
+
+class Decoder:
+    """Splits a byte stream into frames and prints them (samples as CSV, anything else as comments)."""
+
+    def __init__(self, out):
+        self.out = out
+        self.buffer = bytearray()
+        self.sequence = None
+        self.frames = 0
+        self.errors = 0
+        self.lost = 0
+
+    def feed(self, data):
+        for byte in data:
+            if byte:
+                self.buffer.append(byte)
+                continue
+            if self.buffer:  # (consecutive delimiters are fine)
+                self.handle(cobs_decode(bytes(self.buffer)))
+            self.buffer.clear()
+
+    def handle(self, raw):
+        if not raw or len(raw) < 4 or crc16(raw[:-2]) != struct.unpack("<H", raw[-2:])[0]:
+            self.errors += 1
+            return
+
+        kind, sequence, payload = raw[0], raw[1], raw[2:-2]
+        self.frames += 1
+
+        if kind == FRAME_SAMPLE and len(payload) >= 5:
+            if self.sequence is not None:
+                self.lost += (sequence - self.sequence - 1) & 0xFF  # dropped by the sender (transmit buffer full)
+            self.sequence = sequence
+
+            time, count = struct.unpack("<IB", payload[:5])
+            for i in range(min(count, (len(payload) - 5) // 6)):
+                index, rpm, duty, flags = struct.unpack("<BHHB", payload[5 + 6 * i:11 + 6 * i])
+                health = flags >> 4
+                self.out.write("%d,%d,%d,%.2f,%d,%s\n" % (time, index, rpm, duty * 100.0 / 65535, flags & 0x01,
+                                                          HEALTH[health] if health < len(HEALTH) else health))
+        elif kind == FRAME_ACK and len(payload) == 2:
+            status = payload[1]
+            self.out.write("# ack: sequence %d, command 0x%02x, %s\n" % (sequence, payload[0],
+                                                                      STATUS[status] if status < len(STATUS) else status))
+        else:
+            self.out.write("# frame 0x%02x: %s\n" % (kind, payload.hex()))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Four Wire Fan telemetry decoder")
+    parser.add_argument("source", nargs="?", default="-", help="serial port, recording, or - for stdin")
+    parser.add_argument("--baud", type=int, default=115200, help="serial baud rate")
+    parser.add_argument("--set-pwm", type=int, nargs=2, metavar=("FAN", "PWM"), help="set a fan's PWM set point (in %%)")
+    parser.add_argument("--set-rpm", type=int, nargs=2, metavar=("FAN", "RPM"), help="set a fan's speed via its model")
+    parser.add_argument("--set-duty", type=int, nargs=2, metavar=("FAN", "DUTY"), help="set a fan's duty cycle (in 1/65535)")
+    parser.add_argument("--sequence", type=int, default=0, help="the command's sequence number (echoed by its acknowledgement)")
+    parser.add_argument("--encode", action="store_true", help="print the encoded command as a C array and exit")
+    args = parser.parse_args()
+
+    request = command(args, args.sequence & 0xFF)
+
+    if args.encode:
+        if request:
+            print("{" + ", ".join("0x%02x" % byte for byte in request) + "}")
+        return
+
+    decoder = Decoder(sys.stdout)
+    sys.stdout.write("time,fan,rpm,duty,spinup,health\n")
+
+    try:
+        if args.source == "-":
+            decoder.feed(sys.stdin.buffer.read())
+        elif args.source.startswith("/dev/") or args.source.upper().startswith("COM"):
+            import serial  # pyserial
+
+            with serial.Serial(args.source, args.baud, timeout=0.1) as port:
+                if request:
+                    port.write(request)
+                while True:
+                    decoder.feed(port.read(4096))
+        else:
+            with open(args.source, "rb") as recording:
+                decoder.feed(recording.read())
+    except KeyboardInterrupt:
+        pass
+
+    sys.stderr.write("%d frames, %d dropped by the sender, %d damaged\n" % (decoder.frames, decoder.lost, decoder.errors))
+
+
+if __name__ == "__main__":
+    main()
@@ -63,11 +63,120 @@ void FourWireFan::begin()
 void FourWireFan::setup()
 {
     // analogWriteResolution(8);
-    pinMode(this->_settings->tachPin, this->_settings->tachPU);
+    this->setupOutput();
+    this->setupFilter();                            // (before the ISR is attached)
+    this->_tach = this->_settings->tach;            // (none: external interrupt, see `tach()`)
+    this->tach()->begin(this->_settings);
+}
+
+/**
+ * Tachometer input filter setup, i.e. the ISR's own copy of the filter parameters.
+ *
+ * The adaptive filter's minimum is half a pulse period at the model's `maxRPM` (or none without `maxRPM`).
+ *
+ * @since 2026-10-16
+ */
+void FourWireFan::setupFilter()
+{
+    bool adaptive = (FOURWIREFAN_ADAPTIVE == this->_settings->filter);
+    uint32_t rate = (uint32_t) max(this->_model->ppr, (uint8_t) 1) * this->_model->maxRPM; // pulses per minute at `maxRPM`
+    uint32_t tau = adaptive ? (rate ? 30000000UL / rate : 0) : this->_settings->tau;
+
+    noInterrupts();                                 // the ISR reads these (and 32 bit aren't written atomically on an AVR)
+    this->_tau = tau;
+    this->_adaptive = adaptive;
+    interrupts();                                   // never forget!
+}
+
+/**
+ * PWM output setup: a 16 bit timer in phase correct mode at 25 kHz, if requested and available on the PWM pin.
+ *
+ * On any other pin (or microcontroller) this falls back to `analogWrite()`, see `setupTimer()`.
+ *
+ * @since 2026-10-16
+ */
+void FourWireFan::setupOutput()
+{
+    uint8_t pin = this->_settings->pwmPin;
+
+    this->_ocr = (FOURWIREFAN_25KHZ == this->_settings->output) ? FourWireFan::setupTimer(pin) : nullptr;
+
+    if (this->_ocr) {
+        this->write(this->_duty);                   // output the current set point…
+        pinMode(pin, OUTPUT);                       // …before driving the pin
+    }
+}
+
+/**
+ * Sets up a 16 bit timer for PWM in phase correct mode at 25 kHz (see `FOURWIREFAN_PWM_FREQUENCY`) on a pin.
+ *
+ * Timer PWM is available on pins 9, 10, 11 (Timer1) and 5 (Timer3) of the ATmega32U4 and on pins 9, 10 (Timer1) of the ATmega328P.
+ * The duty range is `FOURWIREFAN_PWM_TOP` (i.e. 320 steps at 16 MHz) instead of 255, and updates just write the output compare register.
+ * Fans on the same timer share its frequency, so they should all use timer PWM (and Timer1 can't count tach pulses then, see `FourWireFanTimerTach`).
+ * The pin itself is left as is, i.e. it still needs to be made an output.
+ *
+ * @since 2026-10-16
+ *
+ * @param pin The PWM output pin
+ *
+ * @return volatile uint16_t* The output compare register of the pin (or none if not available)
+ */
+volatile uint16_t* FourWireFan::setupTimer(uint8_t pin)
+{
+    volatile uint16_t* ocr = nullptr;
+
+#if defined(__AVR_ATmega32U4__) || defined(__AVR_ATmega328P__)
+    noInterrupts();                                 // going to change timer registers
+
+    switch (pin) {
+        case 9:                                     // OC1A
+            ocr = &OCR1A;
+            TCCR1A |= _BV(COM1A1);                  // non-inverting
+            break;
+        case 10:                                    // OC1B
+            ocr = &OCR1B;
+            TCCR1A |= _BV(COM1B1);
+            break;
+#if defined(__AVR_ATmega32U4__)
+        case 11:                                    // OC1C
+            ocr = &OCR1C;
+            TCCR1A |= _BV(COM1C1);
+            break;
+        case 5:                                     // OC3A
+            ocr = &OCR3A;
+            TCCR3A = _BV(COM3A1) | _BV(WGM31);      // mode 10: phase correct PWM with TOP = ICR3…
+            TCCR3B = _BV(WGM33) | _BV(CS30);        // …without prescaler
+            ICR3 = FOURWIREFAN_PWM_TOP;
+            break;
+#endif
+    }
+
+    if (ocr && (5 != pin)) {                        // Timer1 (shared by up to three fans)
+        TCCR1A = (TCCR1A & ~_BV(WGM10)) | _BV(WGM11); // mode 10: phase correct PWM with TOP = ICR1…
+        TCCR1B = _BV(WGM13) | _BV(CS10);            // …without prescaler
+        ICR1 = FOURWIREFAN_PWM_TOP;
+    }
 
-    noInterrupts();                                 // going to change interrupt variable(s)
-    attachInterrupt(digitalPinToInterrupt(this->_settings->tachPin), this->_settings->tachISR, this->_settings->tachMode);
     interrupts();                                   // never forget!
+#endif
+
+    return ocr;
+}
+
+/**
+ * Sets the PWM output pin duty cycle.
+ *
+ * @since 2026-10-16
+ *
+ * @param duty The duty cycle (in 1/65535)
+ */
+void FourWireFan::write(uint16_t duty)
+{
+    if (this->_ocr) {
+        *this->_ocr = ((uint32_t) duty * FOURWIREFAN_PWM_TOP + 0x8000UL) >> 16; // 1/65535 to TOP (rounded)
+    } else {
+        analogWrite(this->_settings->pwmPin, FourWireFan::toAnalog(duty));      // 1/65535 to 8 bit (rounded)
+    }
 }
 
 /**
@@ -78,12 +187,17 @@ void FourWireFan::setup()
 void FourWireFan::reset() 
 {
     noInterrupts();                                 // going to change interrupt variable(s)
-    this->_blink = 0;                               // reset last debouncing interval
-    this->_pulses = 0;                              // reset pulse counter
+    this->tach()->reset();                          // reset pulse counter
+    this->_sample.now = micros();                   // restart measuring period
     interrupts();                                   // never forget!
     
     this->_spinup = 0;                              // explicitly stop spinup…
     this->_rpm = 0;                                 // …and reset speed value
+    this->_raw = 0;
+
+    if (this->_estimator) {
+        this->_estimator->reset();
+    }
 }
 
 /**
@@ -95,39 +209,138 @@ void FourWireFan::reset()
  */
 void FourWireFan::count()
 {
-    uint32_t now = micros();
-    uint32_t interval = now - this->_blink;
+    FOURWIREFAN_PROFILE_BEGIN(count);
+    bool triggered = this->_counter.count(this->_tau, this->_adaptive, this->_trigger); // the ISR's own copies (see `setupFilter()`)
+    FOURWIREFAN_PROFILE_END(count, FOURWIREFAN_PROBE_COUNT);
 
-    // debouncing (optional, if interval is longer than debounce timeout)
-    if (interval >= this->_settings->tau) {
-        this->_pulses++;
-    }
-    else {
-        this->_blink = now;
+    if (triggered && this->_callback) {
+        this->_callback(this);                      // enough tach edges for an update (see `setTrigger()`)
     }
 }
 
 /**
  * Updates fan operation, e.g. spinning up, tachometer input, speed update, spindown detection.
+ *
+ * For a three wire fan, this opens the tach window and waits for it to pass (unless `poll()` has opened it already).
  * 
  * @since 2020-07-22
  * 
- * @param duration The length of the measuring period since the last call to `update()` (in ms)
+ * @param duration The length of the measuring period since the last call to `update()` (in ms, or 0 to measure it)
  */
 void FourWireFan::update(uint16_t duration)
 {
-    uint32_t pulses;
-    uint8_t targetPWM = this->_model->maxPWM;       // default to maximum fan speed (as a safety measure!)
+    if (this->_settings->stretch && !this->_stretching) {
+        this->stretch();                            // three wire fan: measure within a tach window…
+        delay(this->_settings->stretch);            // …which blocks (unless opened ahead of time by `poll()`)
+    }
+
+    FOURWIREFAN_PROFILE_BEGIN(update);
 
     /* sample tachometer value */
     noInterrupts();                                 // going to change interrupt variables
-    pulses = this->_pulses;                         // save pulses counted during duration
-    this->_pulses = 0;                              // reset pulse counter after successfully sampling it
-    this->_blink = 0;                               // reset debouncing interval so as not to bleed over into next interval
+    FOURWIREFAN_PROFILE_BEGIN(critical);
+    this->sample();
+    FOURWIREFAN_PROFILE_END(critical, FOURWIREFAN_PROBE_CRITICAL);
     interrupts();                                   // never forget!
 
+    this->evaluate(duration);
+    this->apply(this->_target);
+
+    FOURWIREFAN_PROFILE_END(update, FOURWIREFAN_PROBE_UPDATE);
+}
+
+/**
+ * Updates fan operation if a measuring period has passed (i.e. a non-blocking `update()`).
+ *
+ * This returns immediately unless a measurement is due, so it can be called from a busy loop instead of `delay()`.
+ * The actual length of the measuring period is measured, so any jitter in calling this doesn't affect the speed value.
+ * With a trigger, a measurement is due as soon as enough tach edges have arrived, the period being the timeout (see `setTrigger()`).
+ * For a three wire fan, the tach window is opened ahead of the update, so nothing blocks (see `stretch()`).
+ *
+ * @since 2026-10-16
+ *
+ * @param period The minimum length of a measuring period (in ms)
+ *
+ * @return bool Whether the fan has been updated
+ */
+bool FourWireFan::poll(uint16_t period)
+{
+    uint32_t elapsed = micros() - this->_sample.now;
+    uint16_t window = this->_settings->stretch;
+
+    if (window && !this->_stretching && (elapsed + window * 1000UL >= period * 1000UL)) {
+        this->stretch();                            // three wire fan: open the tach window ahead of the update
+    }
+
+    if (((elapsed < period * 1000UL) && !(this->_trigger && this->_counter.isTriggered())) ||
+        (this->_stretching && (micros() - this->_opened < window * 1000UL))) {
+        return false;                               // not due yet
+    }
+
+    this->update(FOURWIREFAN_ELAPSED);
+
+    return true;
+}
+
+/**
+ * Opens the tach window of a three wire fan, i.e. pulse stretching.
+ *
+ * A three wire fan's tach output is powered by its supply, which the PWM output chops, so its tach signal is only valid at full duty.
+ * During the window the fan runs at full duty, and the tach reading restarts, dropping the chopped edges recorded so far.
+ * The window closes with the next sample, after which the set point applies again (see `update()`).
+ * It should be as short as possible, but span at least two tach pulses at minimum speed, since the fan speeds up meanwhile.
+ *
+ * @since 2026-10-16
+ */
+void FourWireFan::stretch()
+{
+    this->write(0xFFFF);                            // power the tach output
+
+    noInterrupts();                                 // going to change interrupt variables
+    this->tach()->reset();                          // forget chopped edges…
+    this->_opened = micros();                       // …and measure within the window only
+    interrupts();                                   // never forget!
+
+    this->_stretching = true;
+}
+
+/**
+ * Samples the tachometer input and restarts the measuring period.
+ *
+ * This must be called with interrupts disabled (see `update()`).
+ *
+ * @since 2026-10-16
+ */
+void FourWireFan::sample()
+{
+    FourWireFanSample* sample = &this->_sample;
+    uint32_t now = micros();
+
+    sample->elapsed = now - sample->now;            // save actual length of measuring period…
+    sample->window = this->_stretching ? now - this->_opened : 0; // …the tach window (three wire fan only)…
+    sample->now = now;                              // …and moment of sampling
+    this->tach()->sample(sample);                   // save pulses counted during duration (and recorded edges)
+    this->_stretching = false;                      // (closes the tach window)
+}
+
+/**
+ * Evaluates the most recent sample, e.g. speed update, spindown detection, spinning up.
+ *
+ * The resulting duty cycle isn't applied yet, see `apply()`.
+ *
+ * @since 2026-10-16
+ *
+ * @param duration The length of the measuring period of the sample (in ms, or 0 to use the measured one)
+ */
+void FourWireFan::evaluate(uint16_t duration)
+{
+    FourWireFanSample* sample = &this->_sample;
+    uint32_t elapsed = duration ? duration * 1000UL : sample->elapsed; // length of measuring period (in µs)
+    uint32_t span = sample->window ? sample->window : elapsed; // span of the tach reading (three wire fan: the tach window)
+    uint16_t targetDuty = FourWireFan::toDuty(this->_model->maxPWM); // default to maximum fan speed (as a safety measure!)
+
     /**
-     * Two impulses per revolution are converted to revolutions per minute.
+     * Two impulses per revolution (see the fan model) are converted to revolutions per minute.
      * The algorithm is very simple and assumess that any four wire fan adheres to at least the original Intel specification.
      * At this point most of the actual work has already been done via the `count()` method and its debouncing/filtering action.
      * 
@@ -141,32 +354,225 @@ void FourWireFan::update(uint16_t duration)
      * // store new rpm value:
      * this->_rpm = (uint32_t) rpm;                    // explicit conversion from double to unsigned long
      * 
+     * Since most AVRs lack an FPU, the same is done in integer arithmetic (see `pulsesToRPM()`).
+     * 
      * @see "4-Wire Pulse Width Modulation (PWM) Controlled Fans", Intel Corporation September 2005, revision 1.3 
      * @see "Noctua PWM specifications white paper", www.noctua.at
      */
 
-    /* alternatively: calculate, normalise and store new rpm value in one go */
-    this->_rpm = (uint32_t) pulses * 60.0f / 2.0f / (duration / 1000.0f);  // (two) pulses per revolution to revolutions per minute
+    uint32_t resolution = 0;                        // speed equivalent of a single pulse (edge timing: none)
 
-    /* detect spindown */
-    if ((this->_rpm <= this->_model->minRPM) &&     // motor not faster than minimum speed
+    if (this->_trigger && this->tach()->hasEdges()) { // event driven: over the exact edge span (no new edge: standstill)
+        this->_raw = sample->intervals ? FourWireFan::pulsesToRPM(sample->intervals, sample->span, this->_model->ppr) : 0;
+    } else if ((FOURWIREFAN_PERIOD == this->_settings->method) && this->tach()->hasEdges()) {
+        this->_raw = this->period(sample->stored, sample->newest, sample->oldest, sample->now);
+    } else {
+        this->_raw = FourWireFan::pulsesToRPM(sample->pulses, span, this->_model->ppr);
+        resolution = FourWireFan::pulsesToRPM(1, span, this->_model->ppr);
+    }
+
+    /* estimate (from the duty cycle applied during the measuring period) */
+    if (this->_estimator) {
+        uint8_t pwm = ((uint32_t) this->_applied * 100 + 0x7FFF) / 0xFFFF;
+        this->_rpm = this->_estimator->update(this->_raw, resolution, this->_model->toRPM(pwm), elapsed);
+    } else {
+        this->_rpm = this->_raw;
+    }
+
+    /* detect spindown (a counted reading is only conclusive if one more pulse wouldn't have made a difference, or if it's none) */
+    uint32_t margin = this->_estimator ? 0 : resolution;
+
+    if (((0 == this->_rpm) || (this->_rpm + margin <= this->_model->minRPM)) && // motor not faster than minimum speed
         (this->_pwm >= this->_model->minPWM)) {     // *and* set point higher than that?
         this->_spinup = this->_model->spinup;       // apply motor spin
     }
 
     /* handle spinup (see: https://en.wiktionary.org/wiki/percussive_maintenance) */
-    if ((0 < this->_spinup) &&                      // spinup condition is met
-        (this->getRPM() >= this->_model->minRPM)) { // *and* fan has started to move?
-        // reduce remaining spinup duration (down to zero)
-        this->_spinup -= duration;
+    if (0 < this->_spinup) {                        // spinup condition is met
+        if (this->getRPM() >= this->_model->minRPM) { // *and* fan has started to move?
+            // reduce remaining spinup duration (down to zero)
+            this->_spinup -= elapsed / 1000;
+        }
         // in case the fan doesn't show signs of movement yet, keep trying…
     } else {
         // spinup condition not met (a.k.a. normal operation)
-        targetPWM = this->_pwm;
+        targetDuty = this->shape(this->_duty, elapsed);
+    }
+
+    this->_target = targetDuty;                     // to be applied (see `apply()`)
+}
+
+/**
+ * Shapes the duty cycle set point on its way to the PWM output: forbidden speed bands are skipped, changes are rate limited.
+ *
+ * A set point within a forbidden band is moved to the band's edge on the side the fan is on (see `FourWireFanModel::skip()`).
+ * The duty cycle then approaches it at the slew rate (see `setSlewRate()`), except for crossing a forbidden band,
+ * which takes a single update. That's a handful of integer operations per update, and none without slew rate and bands.
+ *
+ * @since 2026-10-16
+ *
+ * @param duty The duty cycle set point (in 1/65535)
+ * @param elapsed The time since the previous update (in µs)
+ *
+ * @return uint16_t The duty cycle to apply (in 1/65535)
+ */
+uint16_t FourWireFan::shape(uint16_t duty, uint32_t elapsed)
+{
+    uint16_t current = this->_applied;
+    uint16_t target = this->_model->skip(duty, current); // rest outside of the forbidden bands
+    uint8_t rate = (target > current) ? this->_rise : this->_fall;
+
+    if ((0 == rate) || (target == current)) {
+        return target;
+    }
+
+    uint32_t step = (uint32_t) rate * 65535 / 100 * min(elapsed / 1000, 10000UL) / 1000; // in 1/65535 per update
+    step = max(step, 1UL);
+
+    if (target > current) {
+        duty = min((uint32_t) target, current + step);
+    } else {
+        duty = ((uint32_t) (current - target) > step) ? current - step : target;
     }
 
+    return this->_model->skip(duty, target);        // cross a forbidden band at once
+}
+
+/**
+ * Applies a duty cycle to the PWM output and records the update in the history.
+ *
+ * Usually, that's the duty cycle `evaluate()` asked for, unless a group holds it back (see `FourWireFanArray::setBudget()`).
+ *
+ * @since 2026-10-16
+ *
+ * @param duty The duty cycle (in 1/65535)
+ */
+void FourWireFan::apply(uint16_t duty)
+{
     /* update speed set point */
-    analogWrite(this->_settings->pwmPin, 2.55f * targetPWM);
+    this->write(duty);
+    this->_applied = duty;
+
+    /* record history */
+    this->_history.push(this->_sample.now, min(this->_rpm, 65535UL), duty, 0 < this->_spinup);
+}
+
+/**
+ * Calculates fan speed from the mean interval between the most recently recorded tach edges.
+ *
+ * Unlike pulse counting, the resolution doesn't depend on the update period, so a couple of pulses suffice for an accurate reading.
+ * If the fan slows down (or stops), the time since the most recent edge already limits the possible speed.
+ * Without any edge for a second (i.e. below 30 rpm at two pulses per revolution) the fan is considered to be at standstill.
+ *
+ * @since 2026-10-16
+ *
+ * @param stored The number of recorded tach edges
+ * @param newest The moment of the most recent tach edge (in µs)
+ * @param oldest The moment of the oldest recorded tach edge (in µs)
+ * @param now The moment of sampling (in µs)
+ *
+ * @return uint32_t
+ */
+uint32_t FourWireFan::period(uint8_t stored, uint32_t newest, uint32_t oldest, uint32_t now)
+{
+    uint32_t gap = now - newest;                    // time since the most recent edge
+    uint32_t interval;
+
+    if ((stored < 2) || (gap > 1000000L)) {         // not enough (recent) edges for a reliable interval
+        return 0;
+    }
+
+    interval = (newest - oldest) / (stored - 1);    // mean edge-to-edge interval (in µs)
+    interval = max(interval, gap);                  // a pending edge means the fan is at most that fast
+
+    return 60000000UL / ((uint32_t) max(this->_model->ppr, (uint8_t) 1) * max(interval, 1UL)); // pulses per revolution to revolutions per minute
+}
+
+/**
+ * Converts a number of pulses within a period to revolutions per minute, in integer arithmetic.
+ *
+ * Basically, this is `pulses * 60000000 / ppr / elapsed`.
+ * For large pulse counts both the numerator and the denominator are scaled down until the product fits 32 bits.
+ * Since 60000000 is a multiple of 2^8, the first few scaling steps are exact in the numerator.
+ *
+ * @since 2026-10-16
+ *
+ * @param pulses The number of pulses within the period
+ * @param elapsed The length of the period (in µs)
+ * @param ppr The number of pulses per revolution
+ *
+ * @return uint32_t
+ */
+uint32_t FourWireFan::pulsesToRPM(uint32_t pulses, uint32_t elapsed, uint8_t ppr)
+{
+    uint32_t factor = 60000000UL / max(ppr, (uint8_t) 1); // µs per minute and pulse per revolution
+
+    while (pulses > 0xFFFFFFFFUL / factor) {        // scale down until it fits
+        factor >>= 1;
+        elapsed >>= 1;
+    }
+
+    return elapsed ? pulses * factor / elapsed : 0;
+}
+
+/**
+ * Returns the CRC-16 (CCITT, i.e. polynomial 0x1021, initially 0xFFFF) of some data, e.g. of telemetry frames and stored records.
+ *
+ * @since 2026-10-16
+ *
+ * @param data The data
+ * @param size The size of the data (in bytes)
+ * @param crc The CRC so far (e.g. to continue a previous calculation)
+ *
+ * @return uint16_t
+ */
+uint16_t FourWireFan::crc16(const uint8_t* data, uint8_t size, uint16_t crc)
+{
+    for (uint8_t i = 0; i < size; i++) {
+        crc ^= (uint16_t) data[i] << 8;
+
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * Returns the tach pulses counted within the most recent measuring period.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint32_t
+ */
+uint32_t FourWireFan::getPulses()
+{
+    return this->_sample.pulses;
+}
+
+/**
+ * Returns the tach edges rejected (i.e. bounces and glitches) within the most recent measuring period.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint16_t
+ */
+uint16_t FourWireFan::getGlitches()
+{
+    return this->_sample.glitches;
+}
+
+/**
+ * Returns the actual length of the most recent measuring period.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint32_t The length of the measuring period (in µs)
+ */
+uint32_t FourWireFan::getElapsed()
+{
+    return this->_sample.elapsed;
 }
 
 /**
@@ -182,6 +588,18 @@ uint32_t FourWireFan::getRPM()
     return this->_rpm;
 }
 
+/**
+ * Returns measured RPM, i.e. straight from the tach input (the same as `getRPM()` unless there's an estimator).
+ *
+ * @since 2026-10-16
+ *
+ * @return uint32_t
+ */
+uint32_t FourWireFan::getRawRPM()
+{
+    return this->_raw;
+}
+
 /**
  * Updates PWM (duty cycle) according to RPM (i.e. fan speed) via fan model.
  * 
@@ -193,10 +611,8 @@ uint32_t FourWireFan::getRPM()
  */
 FourWireFan* FourWireFan::setRPM(uint32_t rpm)
 {
-    // required pwm for a given rpm via fan model lookup
-    uint32_t pwm = 0; // todo: implement magic here
-
-    this->setPWM(pwm);
+    // required pwm for a given rpm via fan model lookup (clamped to the model's limits)
+    this->setPWM(this->_model->toPWM(min(rpm, 65535UL)));
 
     return this;
 }
@@ -224,6 +640,7 @@ uint32_t FourWireFan::getDebounceTime()
 FourWireFan* FourWireFan::setDebounceTime(uint32_t tau)
 {
     this->_settings->tau = tau;
+    this->setupFilter();                            // hand over to the ISR
 
     return this;
 }
@@ -251,7 +668,60 @@ uint8_t FourWireFan::getPWM()
  */
 FourWireFan* FourWireFan::setPWM(uint8_t pwm) 
 {
-    this->_pwm = max(this->_model->minPWM, min(this->_model->maxPWM, pwm)); // minPWM <= pwm <= maxPWM
+    this->setDuty(FourWireFan::toDuty(pwm));
+
+    return this;
+}
+
+/**
+ * Returns current duty cycle set point.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint16_t The duty cycle (in 1/65535)
+ */
+uint16_t FourWireFan::getDuty()
+{
+    return this->_duty;
+}
+
+/**
+ * Returns the duty cycle actually applied to the PWM output.
+ *
+ * This differs from the set point while spinning up, while shaped (see `setSlewRate()` and the model's bands)
+ * or while held back by an array's duty budget.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint16_t The duty cycle (in 1/65535)
+ */
+uint16_t FourWireFan::getApplied()
+{
+    return this->_applied;
+}
+
+/**
+ * Updates duty cycle set point.
+ *
+ * This is a finer grained `setPWM()`, e.g. for closed loop control: the output resolution is only limited by the PWM output.
+ *
+ * @since 2026-10-16
+ *
+ * @param duty new target duty cycle (in 1/65535, i.e. 0xFFFF is 100%)
+ *
+ * @return FourWireFan*
+ */
+FourWireFan* FourWireFan::setDuty(uint16_t duty)
+{
+    FOURWIREFAN_PROFILE_BEGIN(duty);
+
+    uint16_t lo = FourWireFan::toDuty(this->_model->minPWM);
+    uint16_t hi = FourWireFan::toDuty(this->_model->maxPWM);
+
+    this->_duty = max(lo, min(hi, duty));           // minPWM <= duty <= maxPWM
+    this->_pwm = ((uint32_t) this->_duty * 100 + 32767) / 65535; // in percent (rounded)
+
+    FOURWIREFAN_PROFILE_END(duty, FOURWIREFAN_PROBE_SETPWM);
 
     return this;
 }
@@ -266,6 +736,18 @@ bool FourWireFan::isBlocked()
     return (0 < this->_spinup);
 }
 
+/**
+ * Returns the recent history of the fan, i.e. a record of each `update()` and running statistics of the fan speed.
+ *
+ * @since 2026-10-16
+ *
+ * @return FourWireFanHistory*
+ */
+FourWireFanHistory* FourWireFan::getHistory()
+{
+    return &this->_history;
+}
+
 /**
  * Returns current four wire fan model.
  * 
@@ -290,13 +772,122 @@ FourWireFanModel* FourWireFan::getModel()
 FourWireFan* FourWireFan::setModel(FourWireFanModel* model) 
 {
     // check for safety related out-of-bounds values
-    if ((model->minPWM >= 0) && (model->maxPWM <= 100) && (model->maxPWM > model->minPWM)) {
-        this->_model = model;
+    if ((model->maxPWM <= 100) && (model->maxPWM > model->minPWM)) { // (`minPWM` is unsigned)
+        this->_model = model->prepare();            // (re)build lookup table
+        this->setupFilter();                        // (adaptive filter depends on `maxRPM`)
     }
 
     return this;
 }
 
+/**
+ * Returns current speed estimator.
+ *
+ * @since 2026-10-16
+ *
+ * @return FourWireFanEstimator* The estimator (or none)
+ */
+FourWireFanEstimator* FourWireFan::getEstimator()
+{
+    return this->_estimator;
+}
+
+/**
+ * Updates speed estimator, i.e. `getRPM()` returns a model based estimate instead of the raw measurement (see `getRawRPM()`).
+ *
+ * The estimator relies on the model's reference values, so these should be calibrated (see `FourWireFanCalibration`).
+ *
+ * @since 2026-10-16
+ *
+ * @param estimator The estimator (or none)
+ *
+ * @return FourWireFan*
+ */
+FourWireFan* FourWireFan::setEstimator(FourWireFanEstimator* estimator)
+{
+    this->_estimator = estimator;
+
+    if (estimator) {
+        estimator->reset(this->_rpm);               // start from the current speed
+    }
+
+    return this;
+}
+
+/**
+ * Updates the slew rate, i.e. how fast the duty cycle follows the set point (e.g. to avoid audible surges).
+ *
+ * The duty cycle is rate limited on its way to the PWM output (see `shape()`), while the set point takes effect at once.
+ * Spinning up isn't rate limited (a slow kick is no kick).
+ *
+ * @since 2026-10-16
+ *
+ * @param rise The maximum duty cycle increase (in % per second, 0: none)
+ * @param fall The maximum duty cycle decrease (in % per second, 0: none)
+ *
+ * @return FourWireFan*
+ */
+FourWireFan* FourWireFan::setSlewRate(uint8_t rise, uint8_t fall)
+{
+    this->_rise = rise;
+    this->_fall = fall;
+
+    return this;
+}
+
+/**
+ * Returns the number of tach edge intervals that trigger an update.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint8_t The number of tach edge intervals (0: no trigger, i.e. fixed measuring periods)
+ */
+uint8_t FourWireFan::getTrigger()
+{
+    return this->_trigger;
+}
+
+/**
+ * Updates the number of tach edge intervals that trigger an update, i.e. switches to event driven measuring.
+ *
+ * Once that many edge intervals have arrived, the ISR raises a flag (see `isTriggered()`) and calls the callback (if any),
+ * and `poll()` updates right away, its period being the timeout at low speed or standstill.
+ * The speed is then measured over the exact span of these edges (regardless of the measurement method),
+ * so the resolution is the same at any speed, while the latency drops as the fan speeds up.
+ * The callback runs within the ISR, so it should be short (e.g. set a flag or wake a task), and mustn't update the fan itself.
+ * This requires the default tachometer input (i.e. an external interrupt).
+ *
+ * @since 2026-10-16
+ *
+ * @param edges The number of tach edge intervals (e.g. 8, or 0 for fixed measuring periods)
+ * @param callback The function to call from the ISR once they've arrived (optional)
+ *
+ * @return FourWireFan*
+ */
+FourWireFan* FourWireFan::setTrigger(uint8_t edges, void (*callback)(FourWireFan* fan))
+{
+    noInterrupts();                                 // the ISR reads these (and pointers aren't written atomically on an AVR)
+    this->_trigger = edges;
+    this->_callback = callback;
+    interrupts();                                   // never forget!
+
+    return this;
+}
+
+/**
+ * Shows whether enough tach edges have arrived for an update (see `setTrigger()`), i.e. the ISR's flag.
+ *
+ * The flag is cleared by the next update.
+ *
+ * @since 2026-10-16
+ *
+ * @return bool
+ */
+bool FourWireFan::isTriggered()
+{
+    return this->_trigger && this->_counter.isTriggered();
+}
+
 /**
  * Pre-defined four wire fan settings instances.
  */
@@ -310,3 +901,8 @@ FourWireFanModel DefaultFourWireFanModel = FourWireFanModel();
 
 uint16_t NF_A12_25_refRPM[10] = {240, 420, 660, 870, 1080, 1260, 1400, 1500, 1600, 1700};
 FourWireFanModel NF_A12_25_FanModel = FourWireFanModel(10, 240, 100, 1700, 0, NF_A12_25_refRPM); // Noctua NF-A12x25 model instance.
+
+/**
+ * Pre-defined compile time fan models.
+ */
+const uint16_t NF_A12_25_FlashRPM[10] PROGMEM = {240, 420, 660, 870, 1080, 1260, 1400, 1500, 1600, 1700};
@@ -13,6 +13,19 @@
 
 #include "FourWireFanSettings.h"
 #include "FourWireFanModel.h"
+#include "FourWireFanTach.h"
+#include "FourWireFanHistory.h"
+#include "FourWireFanEstimator.h"
+#include "FourWireFanProfile.h"
+
+#define FOURWIREFAN_ELAPSED 0                           // `update()` duration: measure the actual length of the measuring period
+
+#ifndef FOURWIREFAN_PWM_FREQUENCY
+#define FOURWIREFAN_PWM_FREQUENCY 25000L                // timer PWM output frequency (in Hz, see `FOURWIREFAN_25KHZ`)
+#endif
+#define FOURWIREFAN_PWM_TOP (F_CPU / 2 / FOURWIREFAN_PWM_FREQUENCY) // timer PWM duty range (phase correct: 320 at 16 MHz)
+
+template <uint8_t N> class FourWireFanArray;
 
 /**
  * A four-wire fan driver that provides a PWM speed and tachometer interface.
@@ -40,8 +53,13 @@ class FourWireFan {
         void reset();                                   // Resets measurement values (only)
         void count();                                   // Increments the internal pulse counter (and serves as interrupt callback routine)
         void update(uint16_t duration = 1000);          // Updates fan speed from tachometer pulse input
+        bool poll(uint16_t period = 1000);              // Updates fan speed if a measuring period has passed (non-blocking)
 
         uint32_t getRPM();                              // Returns calculated RPM (i.e. fan speed) 
+        uint32_t getRawRPM();                           // Returns measured RPM (i.e. without estimator)
+        uint32_t getElapsed();                          // Returns actual length of the most recent measuring period (in µs)
+        uint32_t getPulses();                           // Returns tach pulses counted within the most recent measuring period
+        uint16_t getGlitches();                         // Returns tach edges rejected within the most recent measuring period
         FourWireFan* setRPM(uint32_t rpm);              // Updates PWM (duty cycle) according to RPM (i.e. fan speed) via fan model lookup
 
         uint32_t getDebounceTime();                     // Returns current debounce time constant
@@ -50,25 +68,90 @@ class FourWireFan {
         uint8_t getPWM();                               // Returns current PWM set point
         FourWireFan* setPWM(uint8_t pwm);               // Updates PWM set point
 
+        uint16_t getDuty();                             // Returns current duty cycle set point (in 1/65535)
+        FourWireFan* setDuty(uint16_t duty);            // Updates duty cycle set point (in 1/65535, i.e. finer than `setPWM()`)
+        uint16_t getApplied();                          // Returns the duty cycle actually applied to the PWM output (in 1/65535)
+        FourWireFan* setSlewRate(uint8_t rise, uint8_t fall); // Updates the rate limits of the duty cycle (in % per second, 0: none)
+
         bool isBlocked();                               // Shows indication of spindown condition
 
+        FourWireFanHistory* getHistory();               // Returns the recent history (records and statistics) of the fan
+
         FourWireFanModel* getModel();                   // Returns current four wire fan model
         FourWireFan* setModel(FourWireFanModel* model); // Updates four wire fan model
 
+        FourWireFanEstimator* getEstimator();           // Returns current speed estimator (if any)
+        FourWireFan* setEstimator(FourWireFanEstimator* estimator); // Updates speed estimator (none: raw measurement)
+
+        uint8_t getTrigger();                           // Returns the number of tach edge intervals that trigger an update (0: none)
+        FourWireFan* setTrigger(uint8_t edges, void (*callback)(FourWireFan* fan) = nullptr); // Updates the number of tach edge intervals that trigger an update
+        bool isTriggered();                             // Shows whether enough tach edges have arrived for an update
+
+        static uint32_t pulsesToRPM(uint32_t pulses, uint32_t elapsed, uint8_t ppr = 2); // Converts pulses per period (in µs) to revolutions per minute
+        static volatile uint16_t* setupTimer(uint8_t pin); // Sets up 25 kHz timer PWM on a pin, returns its output compare register (or none)
+        static uint16_t crc16(const uint8_t* data, uint8_t size, uint16_t crc = 0xFFFF); // Returns the CRC-16 (CCITT) of some data
+
+        /**
+         * Converts percent to duty cycle (rounded, at compile time for constants).
+         *
+         * @param pwm The duty cycle (in percent)
+         *
+         * @return uint16_t The duty cycle (in 1/65535)
+         */
+        static constexpr uint16_t toDuty(uint8_t pwm) { return ((uint32_t) min(pwm, (uint8_t) 100) * 65535 + 50) / 100; }
+
+        /**
+         * Converts duty cycle to an 8 bit `analogWrite()` value (rounded).
+         *
+         * @param duty The duty cycle (in 1/65535)
+         *
+         * @return uint8_t The duty cycle (in 1/255)
+         */
+        static constexpr uint8_t toAnalog(uint16_t duty) { return (duty - (duty >> 8) + 128) >> 8; }
+
        /* deprecated: */
         void process(uint16_t duration = 1000) { update(duration); }
 
     protected:
+        template <uint8_t N> friend class FourWireFanArray;
+
         FourWireFanSettings* _settings;                 // four wire fan settings
         FourWireFanModel* _model;                       // four wire fan model
 
         uint8_t _pwm = 255;                             // the set point for PWM output pin (default: 100%)
+        uint16_t _duty = 0xFFFF;                        // the set point for PWM output pin (in 1/65535, default: 100%)
+        uint16_t _target = 0xFFFF;                      // the duty cycle asked for by the most recent evaluation (in 1/65535)
+        uint16_t _applied = 0xFFFF;                     // the duty cycle applied to the PWM output pin (in 1/65535, unconnected: 100%)
+        uint8_t _rise = 0;                              // the maximum duty cycle increase (in % per second, 0: none)
+        uint8_t _fall = 0;                              // the maximum duty cycle decrease (in % per second, 0: none)
+        volatile uint16_t* _ocr = nullptr;              // the output compare register of the timer PWM output (none: `analogWrite()`)
         uint32_t _rpm = 0;                              // the calculated RPM (i.e. fan speed)
+        uint32_t _raw = 0;                              // the measured RPM (i.e. before the estimator)
+        FourWireFanEstimator* _estimator = nullptr;     // the speed estimator (none: raw measurement)
         int16_t _spinup = 0;                            // the spinup condition counter
-        volatile uint32_t _blink = 0;                   // the moment of the last interrupt 'wakeup'
-        volatile uint32_t _pulses = 0;                  // the pulses within the current sample period
+        FourWireFanInterruptTach _counter;              // the default tachometer input (external interrupt)
+        uint32_t _tau = 0;                              // the debounce timeout as used by the ISR (only written with interrupts disabled)
+        bool _adaptive = false;                         // the adaptive filter in use by the ISR (only written with interrupts disabled)
+        uint8_t _trigger = 0;                           // the tach edge intervals that trigger an update (0: none, only written with interrupts disabled)
+        void (*_callback)(FourWireFan* fan) = nullptr;  // the function the ISR calls once they've arrived (only written with interrupts disabled)
+        FourWireFanTach* _tach = nullptr;               // the tachometer input in use (none: `_counter`, no pointer into the fan itself, so fans can be copied)
+        FourWireFanSample _sample;                      // the most recent snapshot of the tachometer input
+        FourWireFanHistory _history;                    // the recent history of the fan
+        bool _stretching = false;                       // the tach window of a three wire fan is open (see `stretch()`)
+        uint32_t _opened = 0;                           // the moment the tach window has been opened (in µs)
+
+        FourWireFanTach* tach() { return this->_tach ? this->_tach : &this->_counter; } // the tachometer input in use
 
         void setup();                                   // initial internal pin setup
+        void setupOutput();                             // PWM output setup (timer or `analogWrite()`)
+        void setupFilter();                             // tachometer input filter setup (debounce timeout or adaptive)
+        void write(uint16_t duty);                      // sets PWM output pin duty cycle (in 1/65535)
+        void sample();                                  // snapshot of tachometer input (with interrupts disabled)
+        void evaluate(uint16_t duration);               // speed update, spindown detection and spinup from snapshot (see `_target`)
+        uint16_t shape(uint16_t duty, uint32_t elapsed); // skips forbidden speed bands and rate limits the duty cycle
+        void apply(uint16_t duty);                      // sets the PWM output and records the update in the history
+        void stretch();                                 // opens the tach window of a three wire fan (full duty, measuring restarted)
+        uint32_t period(uint8_t stored, uint32_t newest, uint32_t oldest, uint32_t now); // speed from tach edge intervals
 };
 
 #endif   // __FOURWIREFAN_H__
@@ -0,0 +1,225 @@
+/**
+ * Four Wire Fan
+ *
+ * An Arduino four-wire fan library that provides a PWM speed and tachometer interface.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef __FOURWIREFANARRAY_H__
+#define __FOURWIREFANARRAY_H__
+
+#include "FourWireFan.h"
+
+#if defined(__AVR__)
+#include <new.h>                                    // placement new (Arduino core)
+#else
+#include <new>
+#endif
+
+/**
+ * Tachometer interrupt dispatch, generated at compile time (one per tach pin).
+ *
+ * Each tach pin gets its own interrupt service routine that forwards to the fan registered for that pin.
+ */
+template <uint8_t TachPin>
+class FourWireFanISR {
+    public:
+        static FourWireFan* fan;                    // the fan connected to `TachPin`
+
+        static void handle() {                      // the interrupt service routine for `TachPin`
+            if (fan) {
+                fan->count();
+            }
+        }
+};
+
+template <uint8_t TachPin> FourWireFan* FourWireFanISR<TachPin>::fan = nullptr;
+
+/**
+ * A fixed size array of four wire fans that are sampled together and updated in one pass.
+ *
+ * No hand written interrupt service routines are required, see `FourWireFanISR`.
+ * All fans are sampled within a single critical section, so their measuring periods match exactly.
+ *
+ * The fans are stored within the array itself (like their settings), so no heap memory is used.
+ *
+ * Optionally, the total increase of duty cycle per update is limited to a budget (see `setBudget()`), e.g. to cap the inrush
+ * current when all fans spin up at once after a brown-out. Spin-ups are then staggered and other increases ramped.
+ *
+ * @param N The maximum number of fans
+ */
+template <uint8_t N>
+class FourWireFanArray {
+    public:
+        /**
+         * Connects another fan (up to `N`).
+         *
+         * @param PwmPin   The output pin where the fan's PWM signal input is connected
+         * @param TachPin  The input pin where the fan's tachometer signal output pin is connected (one fan per pin)
+         * @param model    The properties of the fan (default: generic four wire fan)
+         * @param settings The remaining connection settings, e.g. tach mode, debounce timeout and measurement method (default: none)
+         *
+         * @return FourWireFan* The new fan (or none if the array is full)
+         */
+        template <uint8_t PwmPin, uint8_t TachPin>
+        FourWireFan* add(FourWireFanModel* model = &DefaultFourWireFanModel, FourWireFanSettings const& settings = DefaultFanSettings) {
+            if (this->_size >= N) {
+                return nullptr;
+            }
+
+            FourWireFanSettings* slot = &this->_settings[this->_size];
+
+            *slot = settings;
+            slot->pwmPin = PwmPin;
+            slot->tachPin = TachPin;
+            slot->tachISR = &FourWireFanISR<TachPin>::handle;
+
+            FourWireFan* fan = new (this->_fans[this->_size]) FourWireFan(slot, model); // constructed in place, once per fan
+            FourWireFanISR<TachPin>::fan = fan;
+            this->_size++;
+
+            return fan;
+        }
+
+        void reset() {                              // Resets measurement values of all fans
+            for (uint8_t i = 0; i < this->_size; i++) {
+                this->at(i)->reset();
+            }
+        }
+
+        void update(uint16_t duration = 1000) {     // Updates all fans from a common sample of their tach input
+            uint16_t window = 0;
+
+            for (uint8_t i = 0; i < this->_size; i++) {
+                FourWireFan* fan = this->at(i);
+                if (fan->_settings->stretch && !fan->_stretching) {
+                    fan->stretch();                 // three wire fans: measure within tach windows…
+                    window = max(window, fan->_settings->stretch);
+                }
+            }
+
+            if (window) {
+                delay(window);                      // …which blocks (unless opened ahead of time by `poll()`)
+            }
+
+            FOURWIREFAN_PROFILE_BEGIN(update);
+
+            noInterrupts();                         // sample all fans at once…
+            FOURWIREFAN_PROFILE_BEGIN(critical);
+            for (uint8_t i = 0; i < this->_size; i++) {
+                this->at(i)->sample();
+            }
+            FOURWIREFAN_PROFILE_END(critical, FOURWIREFAN_PROBE_CRITICAL);
+            interrupts();                           // …never forget!
+
+            for (uint8_t i = 0; i < this->_size; i++) {
+                this->at(i)->evaluate(duration);
+            }
+
+            this->schedule();
+
+            FOURWIREFAN_PROFILE_END(update, FOURWIREFAN_PROBE_UPDATE);
+        }
+
+        bool poll(uint16_t period = 1000) {         // Updates all fans if a measuring period has passed (non-blocking)
+            if (0 == this->_size) {
+                return false;
+            }
+
+            uint32_t elapsed = micros() - this->at(0)->_sample.now;
+            bool due = (elapsed >= period * 1000UL);
+
+            for (uint8_t i = 0; i < this->_size; i++) {
+                FourWireFan* fan = this->at(i);
+                uint16_t window = fan->_settings->stretch;
+                if (window && !fan->_stretching && (elapsed + window * 1000UL >= period * 1000UL)) {
+                    fan->stretch();                 // three wire fan: open the tach window ahead of the update
+                }
+                if (fan->_stretching && (micros() - fan->_opened < window * 1000UL)) {
+                    due = false;                    // (wait for the tach window to pass)
+                }
+            }
+
+            if (!due) {
+                return false;                       // not due yet
+            }
+
+            this->update(FOURWIREFAN_ELAPSED);
+
+            return true;
+        }
+
+        uint8_t size() { return this->_size; }     // Returns the number of connected fans
+
+        uint16_t getBudget() { return this->_budget; } // Returns the total duty cycle increase per update (in %, 0: unlimited)
+
+        /**
+         * Updates the total duty cycle increase per update, i.e. the sum of all fans' increases (e.g. 100%: one fan from 0 to 100%).
+         *
+         * Each fan gets its increase within the budget, in turn. A spin-up gets its full increase or waits for the next update,
+         * while other increases are granted as far as the budget goes (i.e. ramped).
+         * The turn starts with the fan held back first, so every fan gets its spin-up within `N` updates.
+         *
+         * @param budget The total duty cycle increase (in %, at least 100, or 0 for unlimited)
+         *
+         * @return FourWireFanArray*
+         */
+        FourWireFanArray* setBudget(uint16_t budget) {
+            this->_budget = budget ? max(budget, (uint16_t) 100) : 0;
+
+            return this;
+        }
+
+        FourWireFan* operator[](uint8_t index) {    // Returns a connected fan (or none)
+            return (index < this->_size) ? this->at(index) : nullptr;
+        }
+
+    protected:
+        FourWireFanSettings _settings[N];           // connection settings of each fan
+        alignas(FourWireFan) uint8_t _fans[N][sizeof(FourWireFan)]; // connected fans (in place)
+        uint8_t _size = 0;                          // number of connected fans
+        uint16_t _budget = 0;                       // the total duty cycle increase per update (in %, 0: unlimited)
+        uint8_t _turn = 0;                          // the fan to get its increase first
+
+        FourWireFan* at(uint8_t index) {            // returns a connected fan (unchecked)
+            return reinterpret_cast<FourWireFan*>(this->_fans[index]);
+        }
+
+        void schedule() {                           // applies each fan's duty cycle (within the budget)
+            uint32_t budget = (uint32_t) this->_budget * 65535 / 100; // in 1/65535
+            uint32_t left = budget;
+            uint8_t turn = this->_turn;
+            bool held = false;
+
+            for (uint8_t k = 0; k < this->_size; k++) {
+                uint8_t i = (turn + k) % this->_size;
+                FourWireFan* fan = this->at(i);
+                uint16_t duty = fan->_target;
+                uint16_t applied = fan->_applied;
+
+                if (budget && (duty > applied)) {   // an increase: within the budget
+                    uint16_t step = duty - applied;
+
+                    if (0 < fan->_spinup) {
+                        duty = (step <= left) ? duty : applied; // all or nothing (a partial kick is no kick)…
+                    } else {
+                        duty = applied + min((uint32_t) step, left); // …or ramped
+                    }
+
+                    left -= duty - applied;
+
+                    if ((duty < fan->_target) && !held) {
+                        this->_turn = i;            // first one next time
+                        held = true;
+                    }
+                }
+
+                fan->apply(duty);
+            }
+        }
+};
+
+#endif  // __FOURWIREFANARRAY_H__
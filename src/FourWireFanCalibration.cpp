@@ -0,0 +1,265 @@
+/**
+ * Four Wire Fan
+ *
+ * A non-blocking calibration of a four wire fan.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "Arduino.h"
+#include "FourWireFanCalibration.h"  // https://github.com/sekdiy/FourWireFan
+
+/**
+ * Constructs a new calibration for a fan.
+ *
+ * @since 2026-10-16
+ *
+ * @param fan The fan to calibrate
+ * @param tolerance The maximum change of a settled speed (in %)
+ * @param window The length of a settling window (in ms, at least one update period)
+ */
+FourWireFanCalibration::FourWireFanCalibration(FourWireFan* fan, uint8_t tolerance, uint16_t window) :
+    _fan(fan),
+    _open(0, 0, 100, 0, 0),
+    _tolerance(tolerance),
+    _window(window)
+{
+    /* nop */
+}
+
+/**
+ * Starts calibrating, storing the results in the given model.
+ *
+ * The model's speed reference values, `minPWM`, `minRPM`, `maxPWM`, `maxRPM` and `spinup` are replaced, its `ppr` is used as is.
+ * When done, the fan is switched to that model (see `FourWireFan::setModel()`).
+ *
+ * @since 2026-10-16
+ *
+ * @param model The model to store the results in (e.g. the fan's own one, or a copy of it)
+ */
+void FourWireFanCalibration::begin(FourWireFanModel* model)
+{
+    this->_model = model;
+    this->_previous = this->_fan->getModel();
+    this->_open.ppr = model->ppr;                   // the tach signal is still interpreted the same way
+
+    memset(this->_ref, 0, sizeof(this->_ref));
+    this->_minPWM = 100;
+    this->_minRPM = 0;
+
+    this->_fan->setModel(&this->_open);             // no limits, no spin-up
+    this->_state = FOURWIREFAN_SWEEP;
+    this->apply(100);
+}
+
+/**
+ * Advances the calibration, using the fan's most recently measured speed.
+ *
+ * This should be called right after the fan's `update()`, at least once per settling window.
+ *
+ * @since 2026-10-16
+ *
+ * @return bool Whether the calibration is still running
+ */
+bool FourWireFanCalibration::update()
+{
+    uint32_t rpm = this->_fan->getRawRPM();         // (an estimate would lean on the model being calibrated)
+
+    switch (this->_state) {
+        case FOURWIREFAN_SWEEP:                     // reference points, from 100% down
+            if (this->settle(rpm)) {
+                uint8_t index = this->_duty / 10 - 1;
+                this->_ref[index] = this->_settled;
+
+                if (0 == this->_settled) {
+                    if (9 == index) {               // not even running at full duty: no tach signal
+                        this->abort();
+                        this->_state = FOURWIREFAN_FAILED;
+                        break;
+                    }
+                    this->_state = FOURWIREFAN_RESTART; // stalled (so are the points below): search between here and the last running point
+                    this->apply(100);
+                } else {
+                    this->_minPWM = this->_duty;
+                    this->_minRPM = this->_settled;
+                    this->apply(this->_duty - (10 < this->_duty ? 10 : 1)); // next reference point (or on to the stall search)
+                    if (9 == this->_duty) {
+                        this->_state = FOURWIREFAN_STALL;
+                    }
+                }
+            }
+            break;
+
+        case FOURWIREFAN_RESTART:                   // back to full speed, then down to the last running point
+            if (this->settle(rpm)) {
+                this->_state = FOURWIREFAN_STALL;
+                this->apply(this->_minPWM - 1);
+            }
+            break;
+
+        case FOURWIREFAN_STALL:                     // duty in 1% steps, down until the fan stalls
+            if (this->settle(rpm)) {
+                if (0 < this->_settled) {
+                    this->_minPWM = this->_duty;
+                    this->_minRPM = this->_settled;
+                    if (1 < this->_duty) {
+                        this->apply(this->_duty - 1);
+                    } else {
+                        this->_model->spinup = 0;   // the fan doesn't stall at all, so it doesn't need to spin up either
+                        this->finish();
+                    }
+                } else {
+                    this->_state = FOURWIREFAN_SPINUP; // stalled: time the way back up to the minimum speed
+                    this->apply(100);
+                }
+            }
+            break;
+
+        case FOURWIREFAN_SPINUP:
+            if ((rpm >= this->_minRPM) || (millis() - this->_step >= FOURWIREFAN_CALIBRATION_TIMEOUT)) {
+                this->_model->spinup = min(millis() - this->_step, (unsigned long) FOURWIREFAN_CALIBRATION_TIMEOUT);
+                this->finish();
+            }
+            break;
+
+        default:                                    // idle, done or failed
+            return false;
+    }
+
+    return (FOURWIREFAN_DONE != this->_state) && (FOURWIREFAN_FAILED != this->_state);
+}
+
+/**
+ * Stops calibrating, restoring the fan's previous model.
+ *
+ * @since 2026-10-16
+ */
+void FourWireFanCalibration::abort()
+{
+    if ((FOURWIREFAN_IDLE == this->_state) || (FOURWIREFAN_DONE == this->_state) || (FOURWIREFAN_FAILED == this->_state)) {
+        return;
+    }
+
+    this->_fan->setModel(this->_previous);
+    this->_fan->setPWM(this->_previous->maxPWM);    // safe side
+    this->_state = FOURWIREFAN_IDLE;
+}
+
+/**
+ * Returns the calibration state.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint8_t
+ */
+uint8_t FourWireFanCalibration::getState()
+{
+    return this->_state;
+}
+
+/**
+ * Starts a new step at the given duty cycle.
+ *
+ * @since 2026-10-16
+ *
+ * @param duty The duty cycle (in %)
+ */
+void FourWireFanCalibration::apply(uint8_t duty)
+{
+    this->_duty = duty;
+    this->_fan->setPWM(duty);
+
+    this->_step = millis();
+    this->_mark = this->_step;
+    this->_sum = 0;
+    this->_count = 0;
+    this->_mean = -1;
+}
+
+/**
+ * Shows whether the speed has settled.
+ *
+ * Speeds are averaged over consecutive windows. The speed has settled once the means of two windows differ by no more than
+ * the tolerance (or 10 rpm, whichever is larger), or once the step has taken `FOURWIREFAN_CALIBRATION_TIMEOUT`.
+ *
+ * @since 2026-10-16
+ *
+ * @param rpm The most recently measured speed
+ *
+ * @return bool Whether the speed has settled (see `_settled`)
+ */
+bool FourWireFanCalibration::settle(uint32_t rpm)
+{
+    uint32_t now = millis();
+
+    this->_sum += rpm;
+    this->_count++;
+
+    if (now - this->_step >= FOURWIREFAN_CALIBRATION_TIMEOUT) {
+        this->_settled = this->_sum / this->_count; // good enough (e.g. a speed that keeps oscillating)
+        return true;
+    }
+
+    if (now - this->_mark < this->_window) {
+        return false;                               // window not complete yet
+    }
+
+    uint32_t mean = this->_sum / this->_count;
+    bool settled = (0 <= this->_mean) && ((uint32_t) abs((int32_t) mean - this->_mean) <= max(mean * this->_tolerance / 100, 10UL));
+
+    this->_mean = mean;
+    this->_sum = 0;
+    this->_count = 0;
+    this->_mark = now;
+
+    if (settled) {
+        this->_settled = mean;
+    }
+
+    return settled;
+}
+
+/**
+ * Stores the results in the model and switches the fan to it.
+ *
+ * Reference points below the stall point are extrapolated along the slope between the minimum speed and the next reference
+ * point above it (but kept above zero), since the fan can't be measured there.
+ *
+ * @since 2026-10-16
+ */
+void FourWireFanCalibration::finish()
+{
+    FourWireFanModel* model = this->_model;
+
+    // reference points the fan stalls at are extrapolated down from the stall search (a zero would distort the lookup)
+    uint8_t upper = this->_minPWM;
+    uint16_t rise = 0;
+
+    for (uint8_t i = 0; i < 10; i++) {
+        if (this->_ref[i] && ((i + 1) * 10 > this->_minPWM)) {
+            upper = (i + 1) * 10;                   // the lowest running reference point above `_minPWM`
+            rise = this->_ref[i] - min(this->_ref[i], this->_minRPM);
+            break;
+        }
+    }
+
+    for (uint8_t i = 0; (i < 10) && !this->_ref[i]; i++) {
+        uint8_t duty = (i + 1) * 10;                // (below `_minPWM`)
+        int32_t linear = rise ? (int32_t) this->_minRPM - (int32_t) (this->_minPWM - duty) * rise / max(upper - this->_minPWM, 1) : 0;
+        int32_t proportional = (uint32_t) this->_minRPM * duty / this->_minPWM; // (never below zero)
+
+        this->_ref[i] = max(max(linear, proportional), (int32_t) 1);
+    }
+
+    model->minPWM = this->_minPWM;
+    model->minRPM = this->_minRPM;
+    model->maxPWM = 100;
+    model->maxRPM = this->_ref[9];
+    memcpy(model->refRPM, this->_ref, sizeof(this->_ref));
+
+    this->_fan->setModel(model);                    // (re)builds the lookup table
+    this->_fan->setPWM(model->maxPWM);              // the fan is running at full speed anyway
+    this->_state = FOURWIREFAN_DONE;
+}
@@ -0,0 +1,85 @@
+/**
+ * Four Wire Fan
+ *
+ * An Arduino four-wire fan library that provides a PWM speed and tachometer interface.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef __FOURWIREFANCALIBRATION_H__
+#define __FOURWIREFANCALIBRATION_H__
+
+#include "FourWireFan.h"
+
+#ifndef FOURWIREFAN_CALIBRATION_TIMEOUT
+#define FOURWIREFAN_CALIBRATION_TIMEOUT 10000L          // maximum time per calibration step (in ms)
+#endif
+
+/**
+ * Calibration states.
+ */
+enum FourWireFanCalibrationState : uint8_t {
+    FOURWIREFAN_IDLE = 0,      // not calibrating
+    FOURWIREFAN_SWEEP = 1,     // measuring the speed at 100%, 90%, … 10% duty
+    FOURWIREFAN_RESTART = 2,   // restarting a stalled fan at 100% duty
+    FOURWIREFAN_STALL = 3,     // lowering duty in 1% steps until the fan stalls
+    FOURWIREFAN_SPINUP = 4,    // timing the way from standstill to the minimum speed at 100% duty
+    FOURWIREFAN_DONE = 5,      // calibrated (results in the model)
+    FOURWIREFAN_FAILED = 6     // no tach signal, or no matching preset (model unchanged)
+};
+
+/**
+ * A non-blocking calibration that measures the speed curve of a fan and stores it in a fan model.
+ *
+ * The duty cycle is stepped through the ten reference points (100% down to 10%), then lowered in 1% steps until the fan stalls.
+ * Finally, the fan is restarted at full duty to time its spin-up.
+ * Each step lasts only until the speed has settled: the mean speeds of two consecutive windows differ by no more than the tolerance.
+ *
+ * While calibrating, the fan runs on a permissive model without any spin-up handling, so it shouldn't be controlled otherwise.
+ */
+class FourWireFanCalibration {
+    public:
+        /**
+         * Constructs a new calibration for a fan.
+         *
+         * @param fan        The fan to calibrate
+         * @param tolerance  The maximum change of a settled speed (default: 2%)
+         * @param window     The length of a settling window (default: 500 ms)
+         */
+        FourWireFanCalibration(FourWireFan* fan, uint8_t tolerance = 2, uint16_t window = 500);
+
+        void begin(FourWireFanModel* model);                        // Starts calibrating, storing the results in the given model
+        bool update();                                              // Advances the calibration (call after the fan's `update()`), returns whether it's still running
+        void abort();                                               // Stops calibrating, restoring the fan's previous model
+
+        uint8_t getState();                                         // Returns the calibration state
+
+    protected:
+        FourWireFan* _fan;                                          // the calibrated fan
+        FourWireFanModel* _model = nullptr;                         // the model to store the results in
+        FourWireFanModel* _previous = nullptr;                      // the fan's model before calibration
+        FourWireFanModel _open;                                     // the permissive model used while calibrating
+        uint8_t _tolerance;                                         // the maximum change of a settled speed (in %)
+        uint16_t _window;                                           // the length of a settling window (in ms)
+        uint8_t _state = FOURWIREFAN_IDLE;                          // the calibration state
+        uint8_t _duty = 0;                                          // the duty cycle of the current step (in %)
+
+        uint16_t _ref[10];                                          // the measured speed reference values
+        uint8_t _minPWM = 0;                                        // the lowest duty cycle the fan keeps running at
+        uint16_t _minRPM = 0;                                       // the speed at `_minPWM`
+
+        uint32_t _step = 0;                                         // the start of the current step (in ms)
+        uint32_t _mark = 0;                                         // the start of the current settling window (in ms)
+        uint32_t _sum = 0;                                          // the sum of speeds within the current settling window
+        uint16_t _count = 0;                                        // the number of speeds within the current settling window
+        int32_t _mean = -1;                                         // the mean speed of the previous settling window (none: -1)
+        uint16_t _settled = 0;                                      // the settled speed of the current step
+
+        void apply(uint8_t duty);                                   // starts a new step at the given duty cycle
+        bool settle(uint32_t rpm);                                  // shows whether the speed has settled (see `_settled`)
+        void finish();                                              // stores the results in the model
+};
+
+#endif  // __FOURWIREFANCALIBRATION_H__
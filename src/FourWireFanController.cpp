@@ -0,0 +1,159 @@
+/**
+ * Four Wire Fan
+ *
+ * A closed-loop speed controller for a four wire fan.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "Arduino.h"
+#include "FourWireFanController.h"  // https://github.com/sekdiy/FourWireFan
+
+/**
+ * Constructs a new speed controller for a fan.
+ *
+ * @since 2026-10-16
+ *
+ * @param fan The fan to control
+ * @param kp The proportional gain (in 1/65536 % per rpm)
+ * @param ki The integral gain (in 1/65536 % per rpm·s)
+ * @param kd The derivative gain (in 1/65536 % per rpm/s)
+ */
+FourWireFanController::FourWireFanController(FourWireFan* fan, int16_t kp, int16_t ki, int16_t kd) :
+    _fan(fan),
+    _kp(kp),
+    _ki(ki),
+    _kd(kd)
+{
+    this->reset();
+}
+
+/**
+ * Clears the controller state (integrator and derivative).
+ *
+ * @since 2026-10-16
+ */
+void FourWireFanController::reset()
+{
+    this->_integral = 0;
+    this->_last = this->_fan->getRPM();
+}
+
+/**
+ * Updates the fan's PWM set point from its measured speed.
+ *
+ * This should be called right after the fan's `update()`, using the same duration.
+ * While the fan is spinning up, the controller holds its state, so a blocked fan doesn't wind up the integrator.
+ *
+ * @since 2026-10-16
+ *
+ * @param duration The length of the measuring period since the last call to `update()` (in ms, or 0 to use the measured one)
+ */
+void FourWireFanController::update(uint16_t duration)
+{
+    FourWireFanModel* model = this->_fan->getModel();
+    uint32_t rpm = this->_fan->getRPM();
+    int32_t lo = (int32_t) model->minPWM << 16;     // output limits (in 1/65536 %)
+    int32_t hi = (int32_t) model->maxPWM << 16;
+
+    if (0 == this->_target) {                       // not controlling
+        this->reset();
+        return;
+    }
+
+    if (this->_fan->isBlocked()) {                  // spinning up: hold (don't wind up)
+        this->_last = rpm;
+        return;
+    }
+
+    if (FOURWIREFAN_ELAPSED == duration) {
+        duration = min(this->_fan->getElapsed() / 1000, 1000UL);
+    }
+
+    duration = constrain(duration, 1, 1000);        // longer gaps would only make the integrator jump
+
+    int32_t error = constrain((int32_t) this->_target - (int32_t) rpm, -4096L, 4096L);
+    int32_t delta = constrain((int32_t) rpm - (int32_t) this->_last, -4096L, 4096L);
+
+    int32_t ff = (int32_t) model->toPWM(this->_target) << 16;                                  // feedforward via fan model lookup
+    int32_t p = (int32_t) this->_kp * error;                                                 // proportional
+    int32_t i = (int32_t) this->_ki * error / 125 * duration / 8;                            // integral increment (i.e. `ki * error * duration / 1000`)
+    int32_t d = -constrain((int32_t) this->_kd * delta / duration, -2000000L, 2000000L) * 1000; // derivative on measurement (no set point kick)
+
+    p = constrain(p, lo - hi, hi - lo);             // each term within the output span, so the sum can't overflow
+    d = constrain(d, lo - hi, hi - lo);
+
+    /* anti-windup: don't integrate large (transient) errors, nor any further into saturation */
+    int32_t output = ff + p + this->_integral + d;
+    if ((abs(error) <= (this->_target >> 3)) &&
+        !(((output >= hi) && (i > 0)) || ((output <= lo) && (i < 0)))) {
+        this->_integral = constrain(this->_integral + i, lo - hi, hi - lo);
+    }
+
+    output = constrain(ff + p + this->_integral + d, lo, hi);
+
+    this->_fan->setDuty(min((output + 50) / 100, 65535L)); // 1/65536 % to 1/65535 (rounded)
+    this->_last = rpm;
+}
+
+/**
+ * Returns the target speed.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint16_t
+ */
+uint16_t FourWireFanController::getTarget()
+{
+    return this->_target;
+}
+
+/**
+ * Updates the target speed (zero to stop controlling).
+ *
+ * @since 2026-10-16
+ *
+ * @param rpm The new target speed
+ *
+ * @return FourWireFanController*
+ */
+FourWireFanController* FourWireFanController::setTarget(uint16_t rpm)
+{
+    this->_target = rpm;
+
+    return this;
+}
+
+/**
+ * Updates the controller gains.
+ *
+ * @since 2026-10-16
+ *
+ * @param kp The proportional gain (in 1/65536 % per rpm)
+ * @param ki The integral gain (in 1/65536 % per rpm·s)
+ * @param kd The derivative gain (in 1/65536 % per rpm/s)
+ *
+ * @return FourWireFanController*
+ */
+FourWireFanController* FourWireFanController::setGains(int16_t kp, int16_t ki, int16_t kd)
+{
+    this->_kp = kp;
+    this->_ki = ki;
+    this->_kd = kd;
+
+    return this;
+}
+
+/**
+ * Returns the controlled fan.
+ *
+ * @since 2026-10-16
+ *
+ * @return FourWireFan*
+ */
+FourWireFan* FourWireFanController::getFan()
+{
+    return this->_fan;
+}
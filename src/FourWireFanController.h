@@ -0,0 +1,54 @@
+/**
+ * Four Wire Fan
+ *
+ * An Arduino four-wire fan library that provides a PWM speed and tachometer interface.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef __FOURWIREFANCONTROLLER_H__
+#define __FOURWIREFANCONTROLLER_H__
+
+#include "FourWireFan.h"
+
+/**
+ * A closed-loop speed controller that holds a four wire fan at a target speed.
+ *
+ * The fan model provides the feedforward duty cycle, a fixed-point PID loop corrects the remaining error.
+ * Gains are given in 1/65536 % duty per rpm (proportional), per rpm·s (integral) and per rpm/s (derivative, on measurement).
+ */
+class FourWireFanController {
+    public:
+        /**
+         * Constructs a new speed controller for a fan.
+         *
+         * @param fan The fan to control
+         * @param kp  The proportional gain (default: 0.02 % per rpm)
+         * @param ki  The integral gain (default: 0.1 % per rpm·s)
+         * @param kd  The derivative gain (default: none)
+         */
+        FourWireFanController(FourWireFan* fan, int16_t kp = 1311, int16_t ki = 6554, int16_t kd = 0);
+
+        void reset();                                               // Clears the controller state (integrator and derivative)
+        void update(uint16_t duration = 1000);                      // Updates the fan's PWM set point from its measured speed (call after the fan's `update()`)
+
+        uint16_t getTarget();                                       // Returns the target speed
+        FourWireFanController* setTarget(uint16_t rpm);             // Updates the target speed (zero to stop controlling)
+
+        FourWireFanController* setGains(int16_t kp, int16_t ki, int16_t kd = 0); // Updates the controller gains
+
+        FourWireFan* getFan();                                      // Returns the controlled fan
+
+    protected:
+        FourWireFan* _fan;                                          // the controlled fan
+        uint16_t _target = 0;                                       // the target speed
+        int16_t _kp;                                                // proportional gain (in 1/65536 % per rpm)
+        int16_t _ki;                                                // integral gain (in 1/65536 % per rpm·s)
+        int16_t _kd;                                                // derivative gain (in 1/65536 % per rpm/s)
+        int32_t _integral = 0;                                      // the integrator (in 1/65536 %)
+        uint32_t _last = 0;                                         // the previously measured speed
+};
+
+#endif  // __FOURWIREFANCONTROLLER_H__
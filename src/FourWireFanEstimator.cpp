@@ -0,0 +1,138 @@
+/**
+ * Four Wire Fan
+ *
+ * A model based speed estimator for four wire fans.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "Arduino.h"
+#include "FourWireFanEstimator.h"  // https://github.com/sekdiy/FourWireFan
+
+/**
+ * Restarts the estimate from a given speed, with full uncertainty (i.e. the next measurement is taken as is).
+ *
+ * @since 2026-10-16
+ *
+ * @param rpm The speed to start from
+ */
+void FourWireFanEstimator::reset(uint32_t rpm)
+{
+    this->_rpm = (int32_t) min(rpm, 65535UL) << 4;
+    this->_offset = 0;
+    this->_variance = 0x3FFFFFFFUL;
+}
+
+/**
+ * Fuses a measurement with the model's prediction, i.e. one step of a scalar Kalman filter.
+ *
+ * The prediction moves the estimate towards the expected speed (plus the learnt offset) by the rotor's time constant,
+ * and grows its variance by the drift. The measurement's variance follows from its resolution (pulse counting is
+ * off by up to one pulse) plus the noise. Their ratio sets the gain; a quarter of each correction goes into the offset,
+ * so a model error vanishes from the estimate over time. An innovation beyond three standard deviations isn't noise,
+ * so the variance is reset to it (and the estimate jumps).
+ *
+ * @since 2026-10-16
+ *
+ * @param rpm The measured speed
+ * @param resolution The speed equivalent of one tach pulse within the measuring period (0: edge timing, i.e. no quantisation)
+ * @param expected The speed the model expects at the duty cycle applied during the measuring period
+ * @param elapsed The length of the measuring period (in µs)
+ *
+ * @return uint32_t The estimated speed
+ */
+uint32_t FourWireFanEstimator::update(uint32_t rpm, uint32_t resolution, uint16_t expected, uint32_t elapsed)
+{
+    uint32_t dt = min(elapsed / 1000, 0xFFFFUL);    // in ms
+    uint32_t span = max((uint32_t) this->inertia + dt, 1UL);
+    uint16_t lag = min((dt << 16) / span, 0xFFFFUL); // dt / (inertia + dt), i.e. about 1 - e^(-dt/inertia)
+    uint16_t learn = min((dt << 16) / (span + 3UL * this->inertia), 0xFFFFUL); // the same for four times the time constant
+
+    /* predict */
+    int32_t before = this->_rpm;
+
+    this->_rpm += FourWireFanEstimator::scale(((int32_t) expected << 4) + this->_offset - this->_rpm, lag);
+
+    uint32_t change = (uint32_t) abs(this->_rpm - before) >> 5; // half the predicted change (in rpm), as the time constant is a guess
+    uint32_t step = min((uint32_t) this->drift * dt / 1000 + change, 0x3FFFUL);
+    uint32_t variance = FourWireFanEstimator::scale(FourWireFanEstimator::scale(this->_variance, 0xFFFF - lag), 0xFFFF - lag) + step * step;
+
+    /* measure */
+    uint32_t quantum = min(resolution, 0x3FFFUL);
+    uint32_t jitter = min(this->noise, (uint16_t) 0x3FFF);
+    uint32_t uncertainty = quantum * quantum / 6 + jitter * jitter; // measurement variance (in rpm²)
+
+    int32_t mean = quantum ? (before + this->_rpm) / 2 : this->_rpm; // pulse counting measures the mean speed over the period
+    int32_t innovation = ((int32_t) min(rpm, 65535UL) << 4) - mean; // in 1/16 rpm
+    uint32_t deviation = (uint32_t) ((innovation < 0) ? -innovation : innovation) >> 4; // in rpm
+
+    deviation = min(deviation, 0x7FFFUL);
+
+    if (deviation * deviation / 9 > variance + uncertainty) {
+        variance = deviation * deviation;           // that's no noise (e.g. blocked rotor, restart)
+    }
+
+    /* correct */
+    uint32_t total = min(variance, 0x3FFFFFFFUL) + uncertainty;
+    uint32_t part = min(variance, 0x3FFFFFFFUL);
+
+    while (total > 0xFFFF) {                        // scale down until the gain fits 32 bits
+        total >>= 1;
+        part >>= 1;
+    }
+
+    uint32_t ratio = total ? (part << 16) / total : 0xFFFF;
+    uint16_t gain = min(ratio, 0xFFFFUL);
+    int32_t rpm16 = this->_rpm + FourWireFanEstimator::scale(innovation, gain);
+    int32_t offset = this->_offset + FourWireFanEstimator::scale(innovation, learn);
+
+    this->_rpm = max(rpm16, (int32_t) 0);
+    this->_offset = constrain(offset, (int32_t) -0xFFFFF, (int32_t) 0xFFFFF);
+    this->_variance = FourWireFanEstimator::scale(min(variance, 0x3FFFFFFFUL), 0xFFFF - gain);
+
+    return this->getRPM();
+}
+
+/**
+ * Returns the estimated speed.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint32_t
+ */
+uint32_t FourWireFanEstimator::getRPM()
+{
+    return (this->_rpm + 8) >> 4;                   // rounded
+}
+
+/**
+ * Returns the learnt offset of the model, i.e. how much faster the fan runs than the model expects.
+ *
+ * @since 2026-10-16
+ *
+ * @return int32_t The offset (in rpm)
+ */
+int32_t FourWireFanEstimator::getOffset()
+{
+    return this->_offset / 16;
+}
+
+/**
+ * Returns `value * gain / 65536` in 32 bit arithmetic (for values up to 2^30).
+ *
+ * @since 2026-10-16
+ *
+ * @param value The value
+ * @param gain The gain (in 1/65536)
+ *
+ * @return int32_t
+ */
+int32_t FourWireFanEstimator::scale(int32_t value, uint16_t gain)
+{
+    uint32_t magnitude = (value < 0) ? -(uint32_t) value : (uint32_t) value;
+    uint32_t scaled = (magnitude >> 16) * gain + (((magnitude & 0xFFFF) * gain) >> 16);
+
+    return (value < 0) ? -(int32_t) scaled : (int32_t) scaled;
+}
@@ -0,0 +1,60 @@
+/**
+ * Four Wire Fan
+ *
+ * An Arduino four-wire fan library that provides a PWM speed and tachometer interface.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef __FOURWIREFANESTIMATOR_H__
+#define __FOURWIREFANESTIMATOR_H__
+
+#include "Arduino.h"
+
+/**
+ * A speed estimator that fuses the fan model with tach measurements (see `FourWireFan::setEstimator()`).
+ *
+ * The rotor is modelled as a first order lag towards the speed the model expects at the applied duty cycle, plus a learnt
+ * offset (i.e. the model's error). Each measurement corrects both with the gain of a scalar Kalman filter, so coarse
+ * readings (pulse counting within short update periods) barely move the estimate, while precise ones dominate it.
+ * A measurement far outside the expected spread (a blocked rotor, a restart) resets the uncertainty, so the estimate follows it at once.
+ *
+ * All arithmetic is integer (speeds in 1/16 rpm, gains in 1/65536).
+ */
+class FourWireFanEstimator {
+    public:
+        // public properties to avoid the getter/setter pattern
+        uint16_t inertia;      // the rotor time constant (default: 1000 ms)
+        uint16_t drift;        // how fast the speed may deviate from the model, i.e. the process noise (default: 100 rpm/s)
+        uint16_t noise;        // the measurement noise on top of quantisation, e.g. tach jitter (default: 20 rpm)
+
+        /**
+         * Constructs a new speed estimator.
+         *
+         * @param inertia  The rotor time constant (default: 1000 ms)
+         * @param drift    How fast the speed may deviate from the model (default: 100 rpm/s)
+         * @param noise    The measurement noise on top of quantisation (default: 20 rpm)
+         */
+        FourWireFanEstimator(uint16_t inertia = 1000, uint16_t drift = 100, uint16_t noise = 20) :
+            inertia(inertia),
+            drift(drift),
+            noise(noise)
+        { /* nop */ }
+
+        void reset(uint32_t rpm = 0);                               // Restarts the estimate from a given speed (with full uncertainty)
+        uint32_t update(uint32_t rpm, uint32_t resolution, uint16_t expected, uint32_t elapsed); // Fuses a measurement, returns the estimate
+
+        uint32_t getRPM();                                          // Returns the estimated speed
+        int32_t getOffset();                                        // Returns the learnt offset of the model (in rpm)
+
+        static int32_t scale(int32_t value, uint16_t gain);         // Returns `value * gain / 65536` (without overflow)
+
+    protected:
+        int32_t _rpm = 0;                                           // the estimated speed (in 1/16 rpm)
+        int32_t _offset = 0;                                        // the learnt offset of the model (in 1/16 rpm)
+        uint32_t _variance = 0x3FFFFFFFUL;                          // the variance of the estimate (in rpm², initially unknown)
+};
+
+#endif  // __FOURWIREFANESTIMATOR_H__
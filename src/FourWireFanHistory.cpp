@@ -0,0 +1,176 @@
+/**
+ * Four Wire Fan
+ *
+ * The recent history of a four wire fan.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "Arduino.h"
+#include "FourWireFanHistory.h"
+
+static_assert((FOURWIREFAN_HISTORY > 0) && (FOURWIREFAN_HISTORY <= 128) && (0 == (FOURWIREFAN_HISTORY & (FOURWIREFAN_HISTORY - 1))),
+    "FOURWIREFAN_HISTORY must be a power of two, up to 128");
+
+/**
+ * Records an update and updates the running statistics (producer only, i.e. from `update()`).
+ *
+ * @since 2026-10-16
+ *
+ * @param time The moment of sampling (in µs)
+ * @param rpm The calculated fan speed
+ * @param duty The applied duty cycle (in 1/65535)
+ * @param spinup Spinning up?
+ */
+void FourWireFanHistory::push(uint32_t time, uint16_t rpm, uint16_t duty, bool spinup)
+{
+    FourWireFanStatistics* s = &this->_statistics;
+    uint8_t head = this->_head;
+
+    /* ring buffer */
+    if ((uint8_t) (head - this->_tail) >= FOURWIREFAN_HISTORY) {
+        this->_dropped++;                           // full: the consumer doesn't keep up
+    } else {
+        FourWireFanRecord* record = &this->_records[head & (FOURWIREFAN_HISTORY - 1)];
+
+        record->time = time;
+        record->rpm = rpm;
+        record->duty = duty;
+        record->spinup = spinup;
+
+        FOURWIREFAN_BARRIER();                      // write the record before publishing it
+        this->_head = head + 1;
+    }
+
+    /* statistics */
+    this->_sequence++;                              // odd: update in progress
+    FOURWIREFAN_BARRIER();
+
+    if (this->_restart || (0 == s->count)) {
+        this->_restart = false;
+        s->count = 0;
+        s->min = rpm;
+        s->max = rpm;
+        s->variance = 0;
+        this->_mean = (int32_t) rpm << 8;
+    }
+
+    int32_t delta = ((int32_t) rpm << 8) - this->_mean; // deviation from the previous mean (in 1/256 rpm)
+    int32_t d = constrain(delta / 256, -32767L, 32767L);
+
+    s->count++;
+    s->min = min(s->min, rpm);
+    s->max = max(s->max, rpm);
+    this->_mean += delta / (1 << FOURWIREFAN_SMOOTHING);
+    s->mean = (this->_mean + 128) >> 8;
+    s->variance += (uint32_t) (d * d) >> FOURWIREFAN_SMOOTHING; // i.e. `(1 - a) * (variance + a * d²)`
+    s->variance -= s->variance >> FOURWIREFAN_SMOOTHING;
+
+    FOURWIREFAN_BARRIER();
+    this->_sequence++;                              // even: update done
+}
+
+/**
+ * Returns the number of unread records.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint8_t
+ */
+uint8_t FourWireFanHistory::available()
+{
+    return (uint8_t) (this->_head - this->_tail);
+}
+
+/**
+ * Reads (and removes) the oldest unread records (consumer only).
+ *
+ * @since 2026-10-16
+ *
+ * @param records The records to fill in
+ * @param count The maximum number of records to read
+ *
+ * @return uint8_t The number of records read
+ */
+uint8_t FourWireFanHistory::read(FourWireFanRecord* records, uint8_t count)
+{
+    uint8_t tail = this->_tail;
+    uint8_t head = this->_head;
+    uint8_t n = 0;
+
+    FOURWIREFAN_BARRIER();                          // read the records only after they've been published
+
+    while ((n < count) && (tail != head)) {
+        records[n++] = this->_records[tail & (FOURWIREFAN_HISTORY - 1)];
+        tail++;
+    }
+
+    FOURWIREFAN_BARRIER();                          // copy the records before releasing them
+    this->_tail = tail;
+
+    return n;
+}
+
+/**
+ * Drops all unread records (consumer only).
+ *
+ * @since 2026-10-16
+ */
+void FourWireFanHistory::clear()
+{
+    this->_tail = this->_head;
+}
+
+/**
+ * Returns the number of records dropped since the last call (consumer only).
+ *
+ * @since 2026-10-16
+ *
+ * @return uint16_t
+ */
+uint16_t FourWireFanHistory::getDropped()
+{
+    uint16_t dropped;
+
+    do {
+        dropped = this->_dropped;                   // two byte reads on AVR: retry if torn
+    } while (dropped != this->_dropped);
+
+    uint16_t count = dropped - this->_reported;
+    this->_reported = dropped;
+
+    return count;
+}
+
+/**
+ * Takes a consistent snapshot of the running statistics (consumer only).
+ *
+ * If an update interrupts the copy, it's simply repeated. Not from an ISR, since an interrupted update would never complete.
+ *
+ * @since 2026-10-16
+ *
+ * @param statistics The snapshot to fill in
+ */
+void FourWireFanHistory::getStatistics(FourWireFanStatistics* statistics)
+{
+    uint8_t sequence;
+
+    do {
+        sequence = this->_sequence;
+        FOURWIREFAN_BARRIER();
+        *statistics = this->_statistics;
+        FOURWIREFAN_BARRIER();
+    } while ((sequence & 1) || (sequence != this->_sequence));
+}
+
+/**
+ * Restarts the statistics with the next update (consumer only).
+ *
+ * @since 2026-10-16
+ */
+void FourWireFanHistory::restart()
+{
+    this->_restart = true;
+}
@@ -0,0 +1,83 @@
+/**
+ * Four Wire Fan
+ *
+ * An Arduino four-wire fan library that provides a PWM speed and tachometer interface.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef __FOURWIREFANHISTORY_H__
+#define __FOURWIREFANHISTORY_H__
+
+#include "Arduino.h"
+
+#ifndef FOURWIREFAN_HISTORY
+#define FOURWIREFAN_HISTORY 8                           // number of records kept per fan (a power of two, up to 128)
+#endif
+
+#ifndef FOURWIREFAN_SMOOTHING
+#define FOURWIREFAN_SMOOTHING 3                         // weight of a new value in mean and variance (1/2^n, i.e. 1/8)
+#endif
+
+#define FOURWIREFAN_BARRIER() __asm__ __volatile__ ("" ::: "memory") // keeps the compiler from reordering memory accesses
+
+/**
+ * A record of a single `update()`.
+ */
+struct FourWireFanRecord {
+    uint32_t time;                                      // the moment of sampling (in µs)
+    uint16_t rpm;                                       // the calculated fan speed
+    uint16_t duty;                                      // the applied duty cycle (in 1/65535)
+    bool spinup;                                        // spinning up?
+};
+
+/**
+ * Running statistics of the fan speed.
+ *
+ * Minimum and maximum span all updates since the statistics have been (re)started,
+ * mean and variance are exponentially weighted (see `FOURWIREFAN_SMOOTHING`).
+ */
+struct FourWireFanStatistics {
+    uint32_t count;                                     // the number of updates
+    uint16_t min;                                       // the lowest fan speed
+    uint16_t max;                                       // the highest fan speed
+    uint16_t mean;                                      // the mean fan speed
+    uint32_t variance;                                  // the variance of the fan speed (in rpm²)
+};
+
+/**
+ * The recent history of a fan: a ring buffer of records plus running statistics.
+ *
+ * There's a single producer, i.e. the fan's `update()`, and a single consumer, i.e. any reader.
+ * The producer never blocks (no critical sections), so `update()` may as well be called from a timer ISR.
+ * The consumer must not be called from an ISR, though: `getStatistics()` would spin forever if it interrupted an update.
+ * If the consumer doesn't keep up, the newest records are dropped (and counted), the statistics are updated anyway.
+ */
+class FourWireFanHistory {
+    public:
+        void push(uint32_t time, uint16_t rpm, uint16_t duty, bool spinup); // Records an update (producer only)
+
+        uint8_t available();                            // Returns the number of unread records
+        uint8_t read(FourWireFanRecord* records, uint8_t count = 1); // Reads (and removes) the oldest records
+        void clear();                                   // Drops all unread records
+        uint16_t getDropped();                          // Returns the number of records dropped since the last call
+
+        void getStatistics(FourWireFanStatistics* statistics); // Takes a consistent snapshot of the statistics
+        void restart();                                 // Restarts the statistics with the next update
+
+    protected:
+        FourWireFanRecord _records[FOURWIREFAN_HISTORY]; // the records (ring buffer)
+        volatile uint8_t _head = 0;                     // the number of records written (wrapping, producer only)
+        volatile uint8_t _tail = 0;                     // the number of records read (wrapping, consumer only)
+        volatile uint16_t _dropped = 0;                 // the number of dropped records (producer only)
+        uint16_t _reported = 0;                         // the number of dropped records already reported (consumer only)
+
+        FourWireFanStatistics _statistics = {0, 0, 0, 0, 0}; // the running statistics (producer only)
+        int32_t _mean = 0;                              // the mean fan speed (in 1/256 rpm)
+        volatile uint8_t _sequence = 0;                 // odd while the statistics are being updated (producer only)
+        volatile bool _restart = false;                 // restart requested (set by consumer, cleared by producer)
+};
+
+#endif  // __FOURWIREFANHISTORY_H__
@@ -0,0 +1,201 @@
+/**
+ * Four Wire Fan
+ *
+ * A non-blocking identification of a fan against the library of fan models.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "Arduino.h"
+#include "FourWireFanIdentification.h"  // https://github.com/sekdiy/FourWireFan
+
+/**
+ * Starts identifying, loading the closest preset into the given model.
+ *
+ * The model's `ppr` is used to interpret the tach signal while identifying (the preset's one replaces it when done).
+ * When done, the fan is switched to that model (see `FourWireFan::setModel()`).
+ *
+ * @since 2026-10-16
+ *
+ * @param model The model to load the closest preset into (e.g. the fan's own one)
+ */
+void FourWireFanIdentification::begin(FourWireFanModel* model)
+{
+    this->_model = model;
+    this->_previous = this->_fan->getModel();
+    this->_open.ppr = model->ppr;                   // the tach signal is still interpreted the same way
+
+    this->_minPWM = 100;
+    this->_maxRPM = 0;
+    this->_rampup = 0;
+    this->_preset = FOURWIREFAN_NO_PRESET;
+    this->_distance = 0xFFFF;
+    this->_wires = 0;
+
+    this->_fan->setModel(&this->_open);             // no limits, no spin-up
+    this->_state = FOURWIREFAN_SWEEP;
+    this->apply(100);
+}
+
+/**
+ * Advances the identification, using the fan's most recently measured speed.
+ *
+ * This should be called right after the fan's `update()`, at least once per settling window.
+ * The spin-up time can't be resolved any finer than the update period, so that should be short (e.g. 100 ms).
+ *
+ * @since 2026-10-16
+ *
+ * @return bool Whether the identification is still running
+ */
+bool FourWireFanIdentification::update()
+{
+    uint32_t rpm = this->_fan->getRawRPM();
+
+    switch (this->_state) {
+        case FOURWIREFAN_SWEEP:                     // maximum speed
+            if (this->settle(rpm)) {
+                if (0 == this->_settled) {          // not even running at full duty: no tach signal
+                    this->abort();
+                    this->_state = FOURWIREFAN_FAILED;
+                    break;
+                }
+                this->_maxRPM = this->_settled;
+                this->_state = FOURWIREFAN_STALL;
+                this->apply(50);
+            }
+            break;
+
+        case FOURWIREFAN_STALL:                     // duty in 5% steps, down until the fan stalls
+            if (this->settle(rpm)) {
+                if (this->_settled >= this->_maxRPM / 10U) { // (a stalled rotor may settle on a slow coast before the tach times out)
+                    this->_minPWM = this->_duty;
+                    if (0 < this->_duty) {
+                        this->apply(this->_duty - 5);
+                    } else {
+                        this->_minPWM = 0;          // the fan doesn't stall at all (so its spin-up time remains unknown)
+                        this->finish();
+                    }
+                } else {
+                    if (100 == this->_minPWM) {
+                        this->_minPWM = 55;         // stalled at 50% already
+                    }
+                    this->_state = FOURWIREFAN_SPINUP; // stalled: time the way back up to half the maximum speed
+                    this->apply(100);
+                }
+            }
+            break;
+
+        case FOURWIREFAN_SPINUP:
+            if ((rpm >= this->_maxRPM / 2U) || (millis() - this->_step >= FOURWIREFAN_CALIBRATION_TIMEOUT)) {
+                this->_rampup = min(millis() - this->_step, (unsigned long) FOURWIREFAN_CALIBRATION_TIMEOUT);
+                this->finish();
+            }
+            break;
+
+        default:                                    // idle, done or failed
+            return false;
+    }
+
+    return (FOURWIREFAN_DONE != this->_state) && (FOURWIREFAN_FAILED != this->_state);
+}
+
+/**
+ * Returns the index of the matching preset.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint8_t The index (or `FOURWIREFAN_NO_PRESET` unless done, e.g. if none matched)
+ */
+uint8_t FourWireFanIdentification::getPreset()
+{
+    return this->_preset;
+}
+
+/**
+ * Returns the distance of the closest preset, i.e. how well it matches (see `FourWireFanLibrary::distance()`).
+ *
+ * @since 2026-10-16
+ *
+ * @return uint16_t
+ */
+uint16_t FourWireFanIdentification::getDistance()
+{
+    return this->_distance;
+}
+
+/**
+ * Returns the matching preset's number of wires.
+ *
+ * A three wire fan needs a tach window (see `FourWireFanSettings::stretch`), which the fan's settings have to provide.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint8_t 3 (three wire fan) or 4 (four wire fan), 0 unless done
+ */
+uint8_t FourWireFanIdentification::getWires()
+{
+    return this->_wires;
+}
+
+/**
+ * Returns the measured stall point, i.e. the lowest duty cycle the fan keeps running at.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint8_t The stall point (in %, in 5% steps, 0: doesn't stall)
+ */
+uint8_t FourWireFanIdentification::getStallPWM()
+{
+    return this->_minPWM;
+}
+
+/**
+ * Returns the measured maximum speed.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint16_t
+ */
+uint16_t FourWireFanIdentification::getMaxRPM()
+{
+    return this->_maxRPM;
+}
+
+/**
+ * Returns the measured spin-up time, i.e. from standstill to half the maximum speed at full duty.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint16_t The spin-up time (in ms, 0: unknown)
+ */
+uint16_t FourWireFanIdentification::getRampup()
+{
+    return this->_rampup;
+}
+
+/**
+ * Loads the closest preset into the model and switches the fan to it, unless it's too far off (i.e. a different fan).
+ *
+ * @since 2026-10-16
+ */
+void FourWireFanIdentification::finish()
+{
+    FourWireFanPreset preset;
+    uint8_t closest = FourWireFanLibrary::identify(this->_minPWM, this->_maxRPM, this->_rampup, &this->_distance);
+
+    if ((this->_distance > FOURWIREFAN_IDENTIFICATION_DISTANCE) || !FourWireFanLibrary::get(closest, &preset)) {
+        this->abort();                              // (no match, or an empty library: the previous model stays)
+        this->_state = FOURWIREFAN_FAILED;
+        return;
+    }
+
+    FourWireFanLibrary::load(closest, this->_model);
+    this->_preset = closest;
+    this->_wires = preset.wires;
+
+    this->_fan->setModel(this->_model);
+    this->_fan->setPWM(this->_model->maxPWM);       // the fan is running at full speed anyway
+    this->_state = FOURWIREFAN_DONE;
+}
@@ -0,0 +1,68 @@
+/**
+ * Four Wire Fan
+ *
+ * An Arduino four-wire fan library that provides a PWM speed and tachometer interface.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef __FOURWIREFANIDENTIFICATION_H__
+#define __FOURWIREFANIDENTIFICATION_H__
+
+#include "FourWireFanCalibration.h"
+#include "FourWireFanLibrary.h"
+
+#ifndef FOURWIREFAN_IDENTIFICATION_DISTANCE
+#define FOURWIREFAN_IDENTIFICATION_DISTANCE 50          // the largest distance of a matching preset (see `FourWireFanLibrary::distance()`)
+#endif
+
+/**
+ * A non-blocking identification that measures a fan's signature and loads the closest preset of the `FourWireFanLibrary`.
+ *
+ * The signature is the maximum speed (settled at full duty), the stall point (duty lowered in 5% steps from 50% until the fan
+ * stalls) and the spin-up time (from standstill to half the maximum speed at full duty). That takes a fraction of a calibration,
+ * whose settling windows and states it shares (`FOURWIREFAN_SWEEP` only measures the maximum speed here).
+ *
+ * If even the closest preset is further off than `FOURWIREFAN_IDENTIFICATION_DISTANCE`, it's a different fan: the identification
+ * fails and the fan keeps its previous model (a calibration is the way to go then).
+ *
+ * While identifying, the fan runs on a permissive model without any spin-up handling, so it shouldn't be controlled otherwise.
+ * The tach windows of a three wire fan add full duty, which keeps it from stalling at short update periods.
+ */
+class FourWireFanIdentification : public FourWireFanCalibration {
+    public:
+        /**
+         * Constructs a new identification for a fan.
+         *
+         * @param fan        The fan to identify
+         * @param tolerance  The maximum change of a settled speed (default: 2%)
+         * @param window     The length of a settling window (default: 500 ms)
+         */
+        FourWireFanIdentification(FourWireFan* fan, uint8_t tolerance = 2, uint16_t window = 500) :
+            FourWireFanCalibration(fan, tolerance, window)
+        { /* nop */ }
+
+        void begin(FourWireFanModel* model);                        // Starts identifying, loading the closest preset into the given model
+        bool update();                                              // Advances the identification (call after the fan's `update()`), returns whether it's still running
+
+        uint8_t getPreset();                                        // Returns the index of the matching preset (or `FOURWIREFAN_NO_PRESET`)
+        uint16_t getDistance();                                     // Returns the distance of the closest preset (see `FourWireFanLibrary::distance()`)
+        uint8_t getWires();                                         // Returns the matching preset's number of wires (3: needs a tach window, 0: no match)
+
+        uint8_t getStallPWM();                                      // Returns the measured stall point (in %, 0: doesn't stall)
+        uint16_t getMaxRPM();                                       // Returns the measured maximum speed
+        uint16_t getRampup();                                       // Returns the measured spin-up time (in ms, 0: unknown)
+
+    protected:
+        uint16_t _maxRPM = 0;                                       // the speed at full duty
+        uint16_t _rampup = 0;                                       // the time from standstill to half of `_maxRPM` (in ms)
+        uint8_t _preset = FOURWIREFAN_NO_PRESET;                    // the matching preset
+        uint16_t _distance = 0xFFFF;                                // the distance of the closest preset
+        uint8_t _wires = 0;                                         // the matching preset's number of wires
+
+        void finish();                                              // loads the closest preset into the model (if it matches)
+};
+
+#endif  // __FOURWIREFANIDENTIFICATION_H__
@@ -0,0 +1,174 @@
+/**
+ * Four Wire Fan
+ *
+ * A library of common fan models, stored in flash.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "Arduino.h"
+#include "FourWireFanLibrary.h"  // https://github.com/sekdiy/FourWireFan
+
+/**
+ * The presets (nominal values, rounded; name, minPWM, minRPM, maxPWM, maxRPM, spinup, ppr, wires, stallPWM, rampup, refRPM).
+ */
+const FourWireFanPreset FourWireFanPresets[] PROGMEM = {
+    {"NF-A12x25 PWM",      10,  240, 100, 1700,   0, 2, 4,  5,  700, {240, 420, 660, 870, 1080, 1260, 1400, 1500, 1600, 1700}},
+    {"NF-F12 PWM",         20,  300, 100, 1500,   0, 2, 4, 10,  900, {0}},
+    {"NF-A14 PWM",         20,  300, 100, 1500,   0, 2, 4, 10, 1200, {0}},
+    {"NF-A4x10 5V PWM",    20, 1200, 100, 5000,   0, 2, 4, 15,  250, {0}},
+    {"P12 PWM",             5,  200, 100, 1800,   0, 2, 4,  5,  600, {0}},
+    {"P14 PWM",             5,  200, 100, 1700,   0, 2, 4,  5,  900, {0}},
+    {"Silent Wings 3 120", 20,  300, 100, 1450,   0, 2, 4, 15,  800, {0}},
+    {"NF-P12 redux-1300",  40,  600, 100, 1300, 500, 2, 3, 35,  800, {0}},
+};
+
+/**
+ * Returns the number of presets.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint8_t
+ */
+uint8_t FourWireFanLibrary::size()
+{
+    return sizeof(FourWireFanPresets) / sizeof(FourWireFanPresets[0]);
+}
+
+/**
+ * Copies a preset from flash.
+ *
+ * @since 2026-10-16
+ *
+ * @param index The index of the preset
+ * @param preset The copy
+ *
+ * @return bool Whether there is such a preset
+ */
+bool FourWireFanLibrary::get(uint8_t index, FourWireFanPreset* preset)
+{
+    if (index >= FourWireFanLibrary::size()) {
+        return false;
+    }
+
+    memcpy_P(preset, &FourWireFanPresets[index], sizeof(FourWireFanPreset));
+
+    return true;
+}
+
+/**
+ * Copies a preset into a fan model (apply it to a fan by `FourWireFan::setModel()`).
+ *
+ * Whether the fan needs a tach window (i.e. is a three wire fan) is a connection setting, see `FourWireFanSettings::stretch`.
+ *
+ * @since 2026-10-16
+ *
+ * @param index The index of the preset
+ * @param model The model to copy the preset into
+ *
+ * @return bool Whether there is such a preset (otherwise the model is left as is)
+ */
+bool FourWireFanLibrary::load(uint8_t index, FourWireFanModel* model)
+{
+    FourWireFanPreset preset;
+
+    if (!FourWireFanLibrary::get(index, &preset)) {
+        return false;
+    }
+
+    model->minPWM = preset.minPWM;
+    model->minRPM = preset.minRPM;
+    model->maxPWM = preset.maxPWM;
+    model->maxRPM = preset.maxRPM;
+    model->spinup = preset.spinup;
+    model->ppr = preset.ppr;
+    model->setCoefficients(preset.refRPM);          // (rebuilds the lookup table)
+
+    return true;
+}
+
+/**
+ * Returns the index of a preset by name.
+ *
+ * @since 2026-10-16
+ *
+ * @param name The name of the preset
+ *
+ * @return uint8_t The index (or `FOURWIREFAN_NO_PRESET`)
+ */
+uint8_t FourWireFanLibrary::find(const char* name)
+{
+    for (uint8_t i = 0; i < FourWireFanLibrary::size(); i++) {
+        if (0 == strncmp_P(name, FourWireFanPresets[i].name, FOURWIREFAN_PRESET_NAME)) {
+            return i;
+        }
+    }
+
+    return FOURWIREFAN_NO_PRESET;
+}
+
+/**
+ * Returns the preset closest to a signature (see `distance()`), e.g. as measured by `FourWireFanIdentification`.
+ *
+ * @since 2026-10-16
+ *
+ * @param stallPWM The lowest duty cycle the fan keeps running at (in %, 0: doesn't stall)
+ * @param maxRPM The speed at full duty
+ * @param rampup The time from standstill to half of `maxRPM` at full duty (in ms, 0: unknown)
+ * @param distance The distance of the closest preset (optional)
+ *
+ * @return uint8_t The index of the closest preset (or `FOURWIREFAN_NO_PRESET` if the library is empty)
+ */
+uint8_t FourWireFanLibrary::identify(uint8_t stallPWM, uint16_t maxRPM, uint16_t rampup, uint16_t* distance)
+{
+    FourWireFanPreset preset;
+    uint8_t closest = FOURWIREFAN_NO_PRESET;
+    uint16_t least = 0xFFFF;
+
+    for (uint8_t i = 0; i < FourWireFanLibrary::size(); i++) {
+        FourWireFanLibrary::get(i, &preset);
+        uint16_t d = FourWireFanLibrary::distance(&preset, stallPWM, maxRPM, rampup);
+
+        if (d < least) {
+            least = d;
+            closest = i;
+        }
+    }
+
+    if (distance) {
+        *distance = least;
+    }
+
+    return closest;
+}
+
+/**
+ * Returns how far a signature is off a preset.
+ *
+ * Each feature adds 10 points per typical deviation: 10% of the maximum speed (the fan's tolerance), 5% of stall point
+ * (the resolution of `FourWireFanIdentification`) and 25% of spin-up time (which also depends on the supply).
+ * So a distance up to about 20 is a plausible match, anything beyond 50 is a different fan.
+ *
+ * @since 2026-10-16
+ *
+ * @param preset The preset
+ * @param stallPWM The lowest duty cycle the fan keeps running at (in %)
+ * @param maxRPM The speed at full duty
+ * @param rampup The time from standstill to half of `maxRPM` at full duty (in ms, 0: unknown, i.e. ignored)
+ *
+ * @return uint16_t The distance (0: exact match)
+ */
+uint16_t FourWireFanLibrary::distance(FourWireFanPreset* preset, uint8_t stallPWM, uint16_t maxRPM, uint16_t rampup)
+{
+    uint32_t d = (uint32_t) abs((int32_t) maxRPM - preset->maxRPM) * 100 / max(preset->maxRPM, (uint16_t) 1);
+
+    d += (uint32_t) abs((int16_t) stallPWM - preset->stallPWM) * 2;
+
+    if (rampup && preset->rampup) {
+        d += (uint32_t) abs((int32_t) rampup - preset->rampup) * 40 / preset->rampup;
+    }
+
+    return min(d, 0xFFFFUL);
+}
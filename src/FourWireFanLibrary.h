@@ -0,0 +1,56 @@
+/**
+ * Four Wire Fan
+ *
+ * An Arduino four-wire fan library that provides a PWM speed and tachometer interface.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef __FOURWIREFANLIBRARY_H__
+#define __FOURWIREFANLIBRARY_H__
+
+#include "FourWireFanModel.h"
+
+#define FOURWIREFAN_PRESET_NAME 20                      // the maximum length of a preset's name (including the terminating zero)
+#define FOURWIREFAN_NO_PRESET 255                       // `FourWireFanLibrary::find()` and `identify()`: no such preset
+
+/**
+ * A fan model preset, i.e. a fan model as stored in flash, plus the signature it's identified by.
+ */
+struct FourWireFanPreset {
+    char name[FOURWIREFAN_PRESET_NAME];                 // the fan's name
+    uint8_t minPWM;                                     // minimum specified speed setting (in %)
+    uint16_t minRPM;                                    // specified speed at `minPWM`
+    uint8_t maxPWM;                                     // maximum sensible speed setting (in %)
+    uint16_t maxRPM;                                    // specified speed at `maxPWM`
+    uint16_t spinup;                                    // minimum full speed duration during spin up (in ms)
+    uint8_t ppr;                                        // tach pulses per revolution
+    uint8_t wires;                                      // three wire fan (needs a tach window, see `FourWireFanSettings::stretch`) or four wire fan
+    uint8_t stallPWM;                                   // signature: the lowest duty cycle the fan keeps running at (in %)
+    uint16_t rampup;                                    // signature: the time from standstill to half of `maxRPM` at full duty (in ms, as measured at 10 Hz updates)
+    uint16_t refRPM[10];                                // speed reference values (none: all 0)
+};
+
+/**
+ * A library of common fan models, stored in flash (so it takes no RAM until a preset is loaded into a `FourWireFanModel`).
+ *
+ * The presets hold the manufacturers' nominal values, rounded; a particular fan may differ by ±10%.
+ * A fan is identified by the closest match of its stall point, its maximum speed and its spin-up time (see `identify()`),
+ * which is what `FourWireFanIdentification` measures. Signatures of other fans can be measured just the same and added here.
+ */
+class FourWireFanLibrary {
+    public:
+        static uint8_t size();                                      // Returns the number of presets
+        static bool get(uint8_t index, FourWireFanPreset* preset);  // Copies a preset from flash
+        static bool load(uint8_t index, FourWireFanModel* model);   // Copies a preset into a fan model
+        static uint8_t find(const char* name);                      // Returns the index of a preset by name
+
+        static uint8_t identify(uint8_t stallPWM, uint16_t maxRPM, uint16_t rampup, uint16_t* distance = nullptr); // Returns the closest preset to a signature
+        static uint16_t distance(FourWireFanPreset* preset, uint8_t stallPWM, uint16_t maxRPM, uint16_t rampup); // Returns how far a signature is off a preset
+};
+
+extern const FourWireFanPreset FourWireFanPresets[] PROGMEM;
+
+#endif  // __FOURWIREFANLIBRARY_H__
@@ -0,0 +1,236 @@
+/**
+ * Four Wire Fan
+ *
+ * An Arduino four-wire fan library that provides a PWM speed and tachometer interface.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "Arduino.h"
+#include "FourWireFanModel.h"
+
+/**
+ * Updates a single speed reference value.
+ *
+ * @since 2020-07-22
+ *
+ * @param index The index of the reference value (i.e. at `(index + 1) * 10` % duty)
+ * @param rpm The speed at that duty
+ *
+ * @return FourWireFanModel*
+ */
+FourWireFanModel* FourWireFanModel::setCoefficient(uint8_t index, float rpm)
+{
+    if (index < 10) {
+        this->refRPM[index] = rpm;
+    }
+
+    return this->prepare();
+}
+
+/**
+ * Updates all speed reference values (or clears them).
+ *
+ * @since 2020-07-22
+ *
+ * @param refRPM The speed reference values at 10%, 20%, … 100% duty (copied, or none for a linear model between `minPWM` and `maxPWM`)
+ *
+ * @return FourWireFanModel*
+ */
+FourWireFanModel* FourWireFanModel::setCoefficients(const uint16_t refRPM[10])
+{
+    for (uint8_t i = 0; i < 10; i++) {
+        this->refRPM[i] = refRPM ? refRPM[i] : 0;
+    }
+
+    return this->prepare();
+}
+
+/**
+ * Updates a forbidden speed band, e.g. a resonance of the chassis (or clears it).
+ *
+ * A fan doesn't rest within a forbidden band, and it crosses the band within a single update (see `FourWireFan::setSlewRate()`).
+ * The bands should be in ascending order and shouldn't overlap.
+ *
+ * @since 2026-10-16
+ *
+ * @param index The index of the band (less than `FOURWIREFAN_BANDS`)
+ * @param from The lower end of the band (in rpm)
+ * @param to The upper end of the band (in rpm, not above `from`: none)
+ *
+ * @return FourWireFanModel*
+ */
+FourWireFanModel* FourWireFanModel::setBand(uint8_t index, uint16_t from, uint16_t to)
+{
+    if (index < FOURWIREFAN_BANDS) {
+        this->bands[index][0] = from;
+        this->bands[index][1] = to;
+    }
+
+    return this->prepare();
+}
+
+/**
+ * Rebuilds the lookup table (e.g. after changing properties directly).
+ *
+ * The reference values are made monotone in place, so that each speed maps to exactly one duty cycle: `refRPM` is changed,
+ * i.e. a value below its predecessor is raised to it (the model holds its own copy, see `setCoefficients()`).
+ * Then the inverse slope of each segment is precomputed (exact for any rise), leaving a binary search and a multiplication per lookup.
+ * Without reference values, a linear model between (`minPWM`, `minRPM`) and (`maxPWM`, `maxRPM`) is used instead.
+ * Finally, the forbidden speed bands are mapped to duty cycles, so that skipping them takes two comparisons per band.
+ *
+ * @since 2026-10-16
+ *
+ * @return FourWireFanModel*
+ */
+FourWireFanModel* FourWireFanModel::prepare()
+{
+    this->_curve = (0 < this->refRPM[9]);
+
+    if (this->_curve) {
+        for (uint8_t i = 0; i < 9; i++) {
+            this->refRPM[i + 1] = max(this->refRPM[i], this->refRPM[i + 1]);    // monotone (measurement noise)
+            uint16_t rise = this->refRPM[i + 1] - this->refRPM[i];
+            this->_slope[i] = rise ? 655360UL / rise : 0;                       // 10% per segment
+        }
+    } else {
+        uint16_t rise = (this->maxRPM > this->minRPM) ? (this->maxRPM - this->minRPM) : 0;
+        uint32_t run = (uint32_t) (this->maxPWM - min(this->minPWM, this->maxPWM)) << 16;
+        this->_slope[0] = rise ? run / rise : 0;
+    }
+
+    for (uint8_t i = 0; i < FOURWIREFAN_BANDS; i++) {
+        bool band = (this->bands[i][1] > this->bands[i][0]);
+        this->_skip[i][0] = band ? min(this->lookup(this->bands[i][0]) / 100, 65535UL) : 0; // 1/65536 % to 1/65535 (close enough)
+        this->_skip[i][1] = band ? min(this->lookup(this->bands[i][1]) / 100, 65535UL) : 0;
+    }
+
+    return this;
+}
+
+/**
+ * Returns the PWM set point required for a given speed (clamped to `minPWM` and `maxPWM`).
+ *
+ * @since 2026-10-16
+ *
+ * @param rpm The target speed
+ *
+ * @return uint8_t
+ */
+uint8_t FourWireFanModel::toPWM(uint16_t rpm)
+{
+    uint8_t pwm = (this->lookup(rpm) + 0x8000UL) >> 16; // rounded
+
+    return max(this->minPWM, min(this->maxPWM, pwm)); // minPWM <= pwm <= maxPWM
+}
+
+/**
+ * Returns the speed expected at a given PWM set point.
+ *
+ * @since 2026-10-16
+ *
+ * @param pwm The PWM set point (in %)
+ *
+ * @return uint16_t
+ */
+uint16_t FourWireFanModel::toRPM(uint8_t pwm)
+{
+    if (this->_curve) {
+        if (pwm <= 10) {
+            return this->refRPM[0];
+        }
+        if (pwm >= 100) {
+            return this->refRPM[9];
+        }
+
+        uint8_t i = pwm / 10 - 1;
+        return this->refRPM[i] + (uint32_t) (this->refRPM[i + 1] - this->refRPM[i]) * (pwm % 10) / 10;
+    }
+
+    if ((pwm <= this->minPWM) || (this->maxPWM <= this->minPWM)) {
+        return this->minRPM;
+    }
+    if (pwm >= this->maxPWM) {
+        return this->maxRPM;
+    }
+
+    return this->minRPM + (int32_t) (this->maxRPM - this->minRPM) * (pwm - this->minPWM) / (this->maxPWM - this->minPWM);
+}
+
+/**
+ * Returns a duty cycle outside of the forbidden speed bands (see `setBand()`).
+ *
+ * A duty cycle within a band is moved to the band's edge on the given side, e.g. the side the fan is currently on,
+ * so that the fan stays there (rather than flapping between the edges), or the side it's heading to, so that it crosses the band.
+ * If the side is within the band as well, the nearest edge is used.
+ *
+ * @since 2026-10-16
+ *
+ * @param duty The duty cycle (in 1/65535)
+ * @param side The duty cycle on the preferred side (in 1/65535)
+ *
+ * @return uint16_t The duty cycle (in 1/65535)
+ */
+uint16_t FourWireFanModel::skip(uint16_t duty, uint16_t side)
+{
+    for (uint8_t i = 0; i < FOURWIREFAN_BANDS; i++) {
+        uint16_t lo = this->_skip[i][0];
+        uint16_t hi = this->_skip[i][1];
+
+        if ((lo < duty) && (duty < hi)) {           // (no band: never)
+            if (side <= lo) {
+                duty = lo;
+            } else if (side >= hi) {
+                duty = hi;
+            } else {
+                duty = (duty - lo < hi - duty) ? lo : hi;
+            }
+        }
+    }
+
+    return duty;
+}
+
+/**
+ * Returns the duty cycle required for a given speed, unclamped.
+ *
+ * @since 2026-10-16
+ *
+ * @param rpm The target speed
+ *
+ * @return uint32_t The duty cycle (in 1/65536 %)
+ */
+uint32_t FourWireFanModel::lookup(uint16_t rpm)
+{
+    if (this->_curve) {
+        if (rpm <= this->refRPM[0]) {
+            return 10UL << 16;
+        }
+        if (rpm >= this->refRPM[9]) {
+            return 100UL << 16;
+        }
+
+        uint8_t lo = 0, hi = 9;                     // refRPM[lo] < rpm < refRPM[hi]
+        while (hi - lo > 1) {
+            uint8_t mid = (lo + hi) / 2;
+            if (rpm < this->refRPM[mid]) {
+                hi = mid;
+            } else {
+                lo = mid;
+            }
+        }
+
+        return ((uint32_t) (lo + 1) * 10 << 16) + (uint32_t) (rpm - this->refRPM[lo]) * this->_slope[lo];
+    }
+
+    if (rpm <= this->minRPM) {
+        return (uint32_t) this->minPWM << 16;
+    }
+    if (rpm >= this->maxRPM) {
+        return (uint32_t) this->maxPWM << 16;
+    }
+
+    return ((uint32_t) this->minPWM << 16) + (uint32_t) (rpm - this->minRPM) * this->_slope[0];
+}
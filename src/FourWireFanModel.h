@@ -13,6 +13,10 @@
 
 #include "Arduino.h"
 
+#ifndef FOURWIREFAN_BANDS
+#define FOURWIREFAN_BANDS 2                             // number of forbidden speed bands per fan model
+#endif
+
 /**
  * Specific properties of a four wire fan.
  * These properties form the 'model' of a fan, allowing better control and safer operation. 
@@ -25,7 +29,9 @@ class FourWireFanModel {
         uint8_t maxPWM;      // maximum sensible speed setting (default: 100%)
         uint16_t maxRPM;     // specified speed at `maxPWM` (default: 1900 rpm)
         uint16_t spinup;     // minimum full speed duration during spin up (default: 0s)
-        uint16_t refRPM[10]; // speed reference values (default: none)
+        uint16_t refRPM[10]; // speed reference values (default: none, made monotone by `prepare()`)
+        uint8_t ppr;         // tach pulses per revolution (default: 2)
+        uint16_t bands[FOURWIREFAN_BANDS][2] = {}; // forbidden speed bands, e.g. chassis resonances (from, to in rpm, default: none)
 
         /**
          * Constructs a new four wire fan settings instance.
@@ -36,17 +42,100 @@ class FourWireFanModel {
          * @param maxRPM     The specified speed at `maxPWM` (default: 1900 rpm)
          * @param spinUp     The minimum full speed duration during spin up (default: 0s)
          * @param refRPM     The fan speed reference values (default: none)
+         * @param ppr        The tach pulses per revolution (default: 2)
          */
-        FourWireFanModel(uint8_t minPWM = 20, uint16_t minRPM = 400, uint8_t maxPWM = 100, uint16_t maxRPM = 2000, uint16_t spinup = 0, uint16_t refRPM[10] = nullptr):
+        FourWireFanModel(uint8_t minPWM = 20, uint16_t minRPM = 400, uint8_t maxPWM = 100, uint16_t maxRPM = 2000, uint16_t spinup = 0, uint16_t refRPM[10] = nullptr, uint8_t ppr = 2):
             minPWM(minPWM),
             minRPM(minRPM),
             maxPWM(maxPWM),
             maxRPM(maxRPM),
-            spinup(spinup)
-        { *this->refRPM = *refRPM; }
+            spinup(spinup),
+            ppr(ppr)
+        { this->setCoefficients(refRPM); }
+
+        FourWireFanModel* setCoefficient(uint8_t index, float rpm);     // Updates a single speed reference value (at `(index + 1) * 10` % duty)
+        FourWireFanModel* setCoefficients(const uint16_t refRPM[10]);   // Updates all speed reference values (or clears them)
+        FourWireFanModel* setBand(uint8_t index, uint16_t from, uint16_t to); // Updates a forbidden speed band (or clears it)
+        FourWireFanModel* prepare();                                    // Rebuilds the lookup table (e.g. after changing properties directly)
+
+        uint8_t toPWM(uint16_t rpm);                                    // Returns the PWM set point required for a given speed
+        uint16_t toRPM(uint8_t pwm);                                    // Returns the speed expected at a given PWM set point
+        uint16_t skip(uint16_t duty, uint16_t side);                    // Returns a duty cycle outside of the forbidden bands (in 1/65535)
+
+    protected:
+        bool _curve = false;                                            // speed reference values available?
+        uint32_t _slope[9];                                             // inverse slopes between reference values (in 1/65536 % per rpm)
+        uint16_t _skip[FOURWIREFAN_BANDS][2] = {};                      // the forbidden bands as duty cycles (in 1/65535, none: 0, 0)
+
+        uint32_t lookup(uint16_t rpm);                                  // the duty cycle required for a given speed (in 1/65536 %, unclamped)
+};
+
+/**
+ * Specific properties of a four wire fan, fixed at compile time (see `FourWireFanT`).
+ *
+ * Unlike `FourWireFanModel`, this takes no RAM at all: the properties are constants and the speed reference values stay in flash.
+ * The reference values must be monotone (they aren't fixed up, unlike `FourWireFanModel::prepare()` does).
+ *
+ * @param MinPWM  The minimum specified speed setting (default: 20%)
+ * @param MinRPM  The specified speed at `MinPWM` (default 400 rpm)
+ * @param MaxPWM  The maximum sensible speed setting (default: 100%)
+ * @param MaxRPM  The specified speed at `MaxPWM` (default: 2000 rpm)
+ * @param Spinup  The minimum full speed duration during spin up (default: 0s)
+ * @param Ppr     The tach pulses per revolution (default: 2)
+ * @param RefRPM  The fan speed reference values in flash, i.e. `PROGMEM` (default: none)
+ */
+template <uint8_t MinPWM = 20, uint16_t MinRPM = 400, uint8_t MaxPWM = 100, uint16_t MaxRPM = 2000, uint16_t Spinup = 0, uint8_t Ppr = 2, const uint16_t* RefRPM = nullptr>
+class FourWireFanConstModel {
+    public:
+        static constexpr uint8_t minPWM = MinPWM;
+        static constexpr uint16_t minRPM = MinRPM;
+        static constexpr uint8_t maxPWM = MaxPWM;
+        static constexpr uint16_t maxRPM = MaxRPM;
+        static constexpr uint16_t spinup = Spinup;
+        static constexpr uint8_t ppr = Ppr;
+        static constexpr bool curve = (nullptr != RefRPM); // speed reference values available?
 
-        FourWireFanModel* setCoefficient(uint8_t index, float rpm) { this->refRPM[index] = rpm; return this; }
-        FourWireFanModel* setCoefficients(uint16_t refRPM[10]) { *this->refRPM = *refRPM; return this; }
+        static_assert((MinPWM < MaxPWM) && (MaxPWM <= 100), "FourWireFanConstModel requires MinPWM < MaxPWM <= 100");
+
+        /**
+         * Returns the PWM set point required for a given speed (clamped to `minPWM` and `maxPWM`).
+         *
+         * There's no precomputed slope table, so each lookup takes one division.
+         *
+         * @param rpm The target speed
+         *
+         * @return uint8_t
+         */
+        static uint8_t toPWM(uint16_t rpm) {
+            uint32_t duty;                          // in 1/256 %
+
+            if (curve) {
+                uint16_t lo = pgm_read_word(&RefRPM[0]);
+                uint16_t hi = lo;
+                uint8_t i = 0;
+
+                while ((i < 9) && (rpm >= (hi = pgm_read_word(&RefRPM[i + 1])))) {
+                    lo = hi;
+                    i++;
+                }
+
+                if ((rpm <= lo) || (9 == i)) {
+                    duty = (uint32_t) (i + 1) * 10 << 8;
+                } else {
+                    duty = ((uint32_t) (i + 1) * 10 << 8) + (uint32_t) (rpm - lo) * 2560 / (hi - lo); // 10% per segment
+                }
+            } else if (rpm <= MinRPM) {
+                duty = (uint32_t) MinPWM << 8;
+            } else if (rpm >= MaxRPM) {
+                duty = (uint32_t) MaxPWM << 8;
+            } else {
+                duty = ((uint32_t) MinPWM << 8) + (uint32_t) (rpm - MinRPM) * ((MaxPWM - MinPWM) << 8) / (MaxRPM > MinRPM ? MaxRPM - MinRPM : 1);
+            }
+
+            uint8_t pwm = (duty + 0x80) >> 8;       // rounded
+
+            return max(MinPWM, min(MaxPWM, pwm));   // minPWM <= pwm <= maxPWM
+        }
 };
 
 /**
@@ -56,4 +145,12 @@ extern FourWireFanModel DefaultThreeWireFanModel;   // Default *three* wire fan
 extern FourWireFanModel DefaultFourWireFanModel;    // Default *four* wire fan model instance.
 extern FourWireFanModel NF_A12_25_FanModel;         // Noctua NF-A12x25 model instance.
 
+/**
+ * Pre-defined compile time fan models.
+ */
+extern const uint16_t NF_A12_25_FlashRPM[10] PROGMEM;
+
+typedef FourWireFanConstModel<> DefaultFourWireFanConstModel;                                        // Default *four* wire fan model.
+typedef FourWireFanConstModel<10, 240, 100, 1700, 0, 2, NF_A12_25_FlashRPM> NF_A12_25_ConstModel;    // Noctua NF-A12x25 model.
+
 #endif  // __FOURWIREFANMODEL_H__
@@ -0,0 +1,218 @@
+/**
+ * Four Wire Fan
+ *
+ * A health monitor for a four wire fan.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "Arduino.h"
+#include "FourWireFanMonitor.h"  // https://github.com/sekdiy/FourWireFan
+
+/**
+ * Constructs a new health monitor for a fan.
+ *
+ * @since 2026-10-16
+ *
+ * @param fan The fan to monitor
+ * @param tolerance The maximum speed deviation from the model (in %, up to 100)
+ * @param hysteresis The margin a speed deviation has to recover by (in %, less than the tolerance)
+ * @param delay The time a condition has to persist before it's flagged (in ms, 0: flagged by the first update it's observed in)
+ */
+FourWireFanMonitor::FourWireFanMonitor(FourWireFan* fan, uint8_t tolerance, uint8_t hysteresis, uint16_t delay) :
+    _fan(fan),
+    _tolerance(min(tolerance, (uint8_t) 100)),
+    _hysteresis(min(hysteresis, _tolerance)),
+    _delay(delay)
+{
+    /* nop */
+}
+
+/**
+ * Clears the health condition (e.g. after replacing the fan).
+ *
+ * @since 2026-10-16
+ */
+void FourWireFanMonitor::reset()
+{
+    this->_health = FOURWIREFAN_HEALTHY;
+    this->_pending = FOURWIREFAN_HEALTHY;
+    this->_since = millis();
+    this->_last = 0;
+    this->_commanded = false;                       // (starting up anew)
+}
+
+/**
+ * Checks the fan's most recently measured speed.
+ *
+ * This should be called right after the fan's `update()`. A condition is flagged (and the callback called) by the first
+ * update after it has persisted for the delay, a lost tach signal and a recovery are flagged right away.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint8_t The health condition (see `FourWireFanHealth`)
+ */
+uint8_t FourWireFanMonitor::update()
+{
+    uint32_t now = millis();
+    uint32_t rpm = this->_fan->getRawRPM();         // (an estimate would lean on the model being judged)
+    uint8_t observed = this->classify(rpm, now);
+
+    this->_last = rpm;
+
+    if (observed != this->_pending) {
+        this->_pending = observed;
+        this->_since = now;
+    }
+
+    if ((observed != this->_health) && ((FOURWIREFAN_HEALTHY == observed) || (FOURWIREFAN_TACH_LOST == observed) || (now - this->_since >= this->_delay))) {
+        this->_health = observed;
+
+        if (this->_callback) {
+            this->_callback(this->_fan, observed);
+        }
+    }
+
+    return this->_health;
+}
+
+/**
+ * Returns the health condition.
+ *
+ * @since 2026-10-16
+ *
+ * @return uint8_t (see `FourWireFanHealth`)
+ */
+uint8_t FourWireFanMonitor::getHealth()
+{
+    return this->_health;
+}
+
+/**
+ * Returns the speed predicted by the model (for the duty cycle applied at the most recent update).
+ *
+ * @since 2026-10-16
+ *
+ * @return uint16_t
+ */
+uint16_t FourWireFanMonitor::getExpected()
+{
+    return this->_expected;
+}
+
+/**
+ * Updates the function called on each change of health (e.g. to fail over to another fan).
+ *
+ * @since 2026-10-16
+ *
+ * @param callback The function to call with the fan and its new health condition (or none)
+ *
+ * @return FourWireFanMonitor*
+ */
+FourWireFanMonitor* FourWireFanMonitor::setCallback(void (*callback)(FourWireFan* fan, uint8_t health))
+{
+    this->_callback = callback;
+
+    return this;
+}
+
+/**
+ * Returns the monitored fan.
+ *
+ * @since 2026-10-16
+ *
+ * @return FourWireFan*
+ */
+FourWireFan* FourWireFanMonitor::getFan()
+{
+    return this->_fan;
+}
+
+/**
+ * Determines the condition observed in the most recent update.
+ *
+ * A running rotor can't stop within a single measuring period, so a period without any tach edges, where the previous speed
+ * would have produced at least two, means a lost tach signal (until edges return). So does a fan that hasn't produced a single
+ * tach edge since it was commanded to run, once it's had time to start up. A slowly failing tach signal can't be told from
+ * a stalling fan, though, nor can a rotor blocked at standstill be told from a broken tach wire.
+ *
+ * @since 2026-10-16
+ *
+ * @param rpm The most recently measured speed
+ * @param now The moment of the update (in ms)
+ *
+ * @return uint8_t The observed condition
+ */
+uint8_t FourWireFanMonitor::classify(uint32_t rpm, uint32_t now)
+{
+    FourWireFanModel* model = this->_fan->getModel();
+    uint16_t applied = this->_fan->getApplied();
+    uint8_t pwm = ((uint32_t) applied * 100 + 32767) / 65535; // in percent (rounded)
+    bool blocked = this->_fan->isBlocked();
+    uint32_t expected = model->toRPM(pwm);
+    bool changed = (expected != this->_expected);   // (the rotor hasn't had a chance to follow yet)
+
+    this->_expected = expected;
+
+    if ((0 == applied) && !blocked) {
+        this->_commanded = false;
+        return FOURWIREFAN_HEALTHY;                 // stopped on purpose
+    }
+
+    if (!this->_commanded || (blocked && !this->_blocked)) {
+        this->_started = this->_started && this->_commanded; // (tach edges are expected anew after a stop)
+        this->_commanded = true;
+        this->_start = now;                         // starting up, or spinning up
+    }
+
+    this->_blocked = blocked;
+
+    uint32_t startup = max((uint32_t) model->spinup, (uint32_t) FOURWIREFAN_MONITOR_STARTUP);
+    bool slow = (FOURWIREFAN_STALLED == this->_pending) || (FOURWIREFAN_DEGRADED == this->_pending);
+    uint8_t held = slow ? this->_pending : (uint8_t) FOURWIREFAN_HEALTHY; // (starting up doesn't prove a slow fan healthy)
+
+    /* tach signal and rotor */
+    if (0 == this->_fan->getPulses()) {
+        uint32_t pulses = this->_last * model->ppr * (this->_fan->getElapsed() / 1000); // previous speed's pulses (in 1/60000)
+
+        if ((FOURWIREFAN_TACH_LOST == this->_pending) || (pulses >= 120000UL) || (!this->_started && (now - this->_start >= startup))) {
+            return FOURWIREFAN_TACH_LOST;
+        }
+    } else {
+        if (FOURWIREFAN_TACH_LOST == this->_pending) {
+            this->_start = now;                     // tach edges are back: give the rotor time to start up (it may have been blocked)
+        }
+        this->_started = true;
+    }
+
+    if (rpm < model->minRPM / 2) {
+        return (now - this->_start < startup) ? held : (uint8_t) FOURWIREFAN_STALLED; // (a rotor starting up is slow)
+    }
+
+    if (blocked) {
+        return held;                                // spinning up: speed deviations are expected
+    }
+
+    /* speed deviation (with hysteresis) */
+    uint32_t lo = expected * (100 - this->_tolerance) / 100;
+    uint32_t hi = expected * (100 + this->_tolerance) / 100;
+    uint32_t margin = expected * this->_hysteresis / 100;
+
+    if (FOURWIREFAN_DEGRADED == this->_pending) {
+        lo += margin;                               // has to recover by the margin
+    }
+    if (FOURWIREFAN_OVERSPEED == this->_pending) {
+        hi -= margin;
+    }
+
+    uint8_t observed = (rpm > hi) ? FOURWIREFAN_OVERSPEED : (rpm < lo) ? FOURWIREFAN_DEGRADED : FOURWIREFAN_HEALTHY;
+    bool following = changed || ((rpm < lo) ? (rpm > this->_last) : (rpm > hi) && (rpm < this->_last));
+
+    if ((observed != this->_pending) && following) {
+        return FOURWIREFAN_HEALTHY;                 // still catching up (e.g. with a new set point)
+    }
+
+    return observed;
+}
@@ -0,0 +1,86 @@
+/**
+ * Four Wire Fan
+ *
+ * An Arduino four-wire fan library that provides a PWM speed and tachometer interface.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef __FOURWIREFANMONITOR_H__
+#define __FOURWIREFANMONITOR_H__
+
+#include "FourWireFan.h"
+
+#ifndef FOURWIREFAN_MONITOR_STARTUP
+#define FOURWIREFAN_MONITOR_STARTUP 1000L               // the least time a fan is given to start up (in ms, or the model's `spinup` if longer)
+#endif
+
+/**
+ * Fan health conditions (in order of precedence).
+ */
+enum FourWireFanHealth : uint8_t {
+    FOURWIREFAN_HEALTHY = 0,   // running as the model predicts
+    FOURWIREFAN_TACH_LOST = 1, // no tach edges at all, although the fan is commanded to run (broken tach wire)
+    FOURWIREFAN_STALLED = 2,   // below half the model's `minRPM` (blocked or worn out rotor)
+    FOURWIREFAN_OVERSPEED = 3, // faster than the model predicts (e.g. broken PWM wire, i.e. full speed)
+    FOURWIREFAN_DEGRADED = 4   // slower than the model predicts (e.g. worn bearing, clogged filter)
+};
+
+/**
+ * A health monitor that compares the measured speed of a four wire fan against the speed its model predicts.
+ *
+ * A condition is flagged by the first update it's observed in (or once it has persisted for the given delay, if any),
+ * a lost tach signal is flagged right away. Speed deviations use hysteresis: a fan flagged as degraded (or overspeeding)
+ * is healthy again only once its speed is back within the tolerance minus the hysteresis.
+ * Changes are reported via `getHealth()` and an optional callback.
+ *
+ * The speed is predicted from the duty cycle actually applied (see `FourWireFan::getApplied()`) via the model's
+ * reference values (see `FourWireFanModel::toRPM()`), so it holds while the duty cycle is shaped or held back.
+ * A deviation the rotor is still catching up with (i.e. its speed moves towards the predicted one) isn't flagged.
+ * While the fan is starting up (see `FOURWIREFAN_MONITOR_STARTUP`), neither a stall nor a missing tach signal is flagged,
+ * and while it's spinning up, no speed deviation is.
+ */
+class FourWireFanMonitor {
+    public:
+        /**
+         * Constructs a new health monitor for a fan.
+         *
+         * @param fan        The fan to monitor
+         * @param tolerance  The maximum speed deviation from the model (default: 20%)
+         * @param hysteresis The margin a speed deviation has to recover by (default: 5%)
+         * @param delay      The time a condition has to persist (default: none, i.e. flagged within one update)
+         */
+        FourWireFanMonitor(FourWireFan* fan, uint8_t tolerance = 20, uint8_t hysteresis = 5, uint16_t delay = 0);
+
+        void reset();                                               // Clears the health condition (e.g. after replacing the fan)
+        uint8_t update();                                           // Checks the fan's most recently measured speed (call after the fan's `update()`), returns its health
+
+        uint8_t getHealth();                                        // Returns the health condition (see `FourWireFanHealth`)
+        uint16_t getExpected();                                     // Returns the speed predicted by the model
+        FourWireFanMonitor* setCallback(void (*callback)(FourWireFan* fan, uint8_t health)); // Updates the function called on each change of health
+
+        FourWireFan* getFan();                                      // Returns the monitored fan
+
+    protected:
+        FourWireFan* _fan;                                          // the monitored fan
+        uint8_t _tolerance;                                         // the maximum speed deviation from the model (in %)
+        uint8_t _hysteresis;                                        // the margin a speed deviation has to recover by (in %)
+        uint16_t _delay;                                            // the time a condition has to persist (in ms)
+        void (*_callback)(FourWireFan* fan, uint8_t health) = nullptr; // the function called on each change of health
+
+        uint8_t _health = FOURWIREFAN_HEALTHY;                      // the reported health condition
+        uint8_t _pending = FOURWIREFAN_HEALTHY;                     // the condition currently observed
+        uint32_t _since = 0;                                        // the moment the observed condition began (in ms)
+        uint16_t _expected = 0;                                     // the speed predicted by the model
+        uint32_t _last = 0;                                         // the previously measured speed
+        bool _commanded = false;                                    // the fan is commanded to run (i.e. not stopped on purpose)
+        bool _started = false;                                      // tach edges have been seen since the fan was commanded to run
+        bool _blocked = false;                                      // the fan was spinning up at the previous update
+        uint32_t _start = 0;                                        // the moment the fan was commanded to run, or began to spin up (in ms)
+
+        uint8_t classify(uint32_t rpm, uint32_t now);               // determines the condition observed in the most recent update
+};
+
+#endif  // __FOURWIREFANMONITOR_H__
@@ -0,0 +1,154 @@
+/**
+ * Four Wire Fan
+ *
+ * Opt-in profiling of the hot path.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "Arduino.h"
+#include "FourWireFanProfile.h"  // https://github.com/sekdiy/FourWireFan
+
+volatile uint32_t FourWireFanProfile::_calls[FOURWIREFAN_PROBES] = {0};
+volatile uint32_t FourWireFanProfile::_total[FOURWIREFAN_PROBES] = {0};
+volatile uint32_t FourWireFanProfile::_max[FOURWIREFAN_PROBES] = {0};
+uint32_t FourWireFanProfile::_overhead = 0;
+
+/**
+ * Records a call of a probe.
+ *
+ * This is called from within the probes (i.e. from the tach ISR, too), so it must stay short.
+ * Each probe is only ever recorded from one context (either the ISR or the main loop), so it needs no critical section.
+ *
+ * @since 2026-10-16
+ *
+ * @param probe The probe (see `FourWireFanProbe`)
+ * @param ticks The cost of the call (in clock ticks, including the probe itself)
+ */
+void FourWireFanProfile::record(uint8_t probe, uint32_t ticks)
+{
+    uint32_t cost = (ticks > FourWireFanProfile::_overhead) ? ticks - FourWireFanProfile::_overhead : 0;
+
+    FourWireFanProfile::_calls[probe]++;
+    FourWireFanProfile::_total[probe] += cost;
+
+    if (cost > FourWireFanProfile::_max[probe]) {
+        FourWireFanProfile::_max[probe] = cost;
+    }
+}
+
+/**
+ * Clears all probes and measures the cost of an empty probe (the least of a few), which is deducted from then on.
+ *
+ * @since 2026-10-16
+ */
+void FourWireFanProfile::reset()
+{
+    uint32_t overhead = 0xFFFFFFFF;
+
+    for (uint8_t i = 0; i < 16; i++) {
+        uint32_t start = FOURWIREFAN_PROFILE_CLOCK();
+        uint32_t ticks = FOURWIREFAN_PROFILE_CLOCK() - start;
+
+        overhead = min(overhead, ticks);
+    }
+
+    noInterrupts();                                 // the ISR records, too
+    for (uint8_t i = 0; i < FOURWIREFAN_PROBES; i++) {
+        FourWireFanProfile::_calls[i] = 0;
+        FourWireFanProfile::_total[i] = 0;
+        FourWireFanProfile::_max[i] = 0;
+    }
+    FourWireFanProfile::_overhead = overhead;
+    interrupts();                                   // never forget!
+}
+
+/**
+ * Returns the number of calls of a probe.
+ *
+ * @since 2026-10-16
+ *
+ * @param probe The probe (see `FourWireFanProbe`)
+ *
+ * @return uint32_t
+ */
+uint32_t FourWireFanProfile::getCalls(uint8_t probe)
+{
+    noInterrupts();                                 // 32 bit aren't read atomically on an AVR
+    uint32_t calls = FourWireFanProfile::_calls[probe];
+    interrupts();                                   // never forget!
+
+    return calls;
+}
+
+/**
+ * Returns the mean cost of a probe.
+ *
+ * @since 2026-10-16
+ *
+ * @param probe The probe (see `FourWireFanProbe`)
+ *
+ * @return uint32_t The mean cost (in ns, 0 without calls)
+ */
+uint32_t FourWireFanProfile::getMean(uint8_t probe)
+{
+    noInterrupts();                                 // 32 bit aren't read atomically on an AVR
+    uint32_t calls = FourWireFanProfile::_calls[probe];
+    uint32_t total = FourWireFanProfile::_total[probe];
+    interrupts();                                   // never forget!
+
+    return calls ? (uint64_t) total * 1000 / FOURWIREFAN_PROFILE_TICKS / calls : 0;
+}
+
+/**
+ * Returns the maximum cost of a probe.
+ *
+ * @since 2026-10-16
+ *
+ * @param probe The probe (see `FourWireFanProbe`)
+ *
+ * @return uint32_t The maximum cost (in ns)
+ */
+uint32_t FourWireFanProfile::getMax(uint8_t probe)
+{
+    noInterrupts();                                 // 32 bit aren't read atomically on an AVR
+    uint32_t ticks = FourWireFanProfile::_max[probe];
+    interrupts();                                   // never forget!
+
+    return FourWireFanProfile::toNanos(ticks);
+}
+
+/**
+ * Returns the worst case tach interrupt latency, i.e. the time from an edge to its ISR.
+ *
+ * An edge waits for the longest critical section, then for the ISRs of all other fans whose edges arrived at the same time.
+ * Interrupt entry and exit (and any other ISRs, e.g. the timer of `micros()`) come on top of that.
+ *
+ * @since 2026-10-16
+ *
+ * @param fans The number of fans (i.e. tach interrupts)
+ *
+ * @return uint32_t The latency (in ns)
+ */
+uint32_t FourWireFanProfile::getLatency(uint8_t fans)
+{
+    uint32_t others = fans ? fans - 1 : 0;
+
+    return FourWireFanProfile::getMax(FOURWIREFAN_PROBE_CRITICAL) + others * FourWireFanProfile::getMax(FOURWIREFAN_PROBE_COUNT);
+}
+
+/**
+ * Converts clock ticks to ns (see `FOURWIREFAN_PROFILE_TICKS`).
+ *
+ * @since 2026-10-16
+ *
+ * @param ticks The clock ticks
+ *
+ * @return uint32_t The time (in ns)
+ */
+uint32_t FourWireFanProfile::toNanos(uint64_t ticks)
+{
+    return min(ticks * 1000 / FOURWIREFAN_PROFILE_TICKS, (uint64_t) 0xFFFFFFFF);
+}
@@ -0,0 +1,73 @@
+/**
+ * Four Wire Fan
+ *
+ * An Arduino four-wire fan library that provides a PWM speed and tachometer interface.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef __FOURWIREFANPROFILE_H__
+#define __FOURWIREFANPROFILE_H__
+
+#include "Arduino.h"
+
+#ifndef FOURWIREFAN_PROFILE
+#define FOURWIREFAN_PROFILE 0                           // instrument the hot path (see `FourWireFanProfile`, default: off)
+#endif
+#ifndef FOURWIREFAN_PROFILE_CLOCK
+#define FOURWIREFAN_PROFILE_CLOCK() micros()            // the clock of the probes (e.g. a cycle counter, if there is one)
+#endif
+#ifndef FOURWIREFAN_PROFILE_TICKS
+#define FOURWIREFAN_PROFILE_TICKS 1                     // clock ticks per µs (`micros()`: 1, at a resolution of 4 µs at 16 MHz)
+#endif
+
+/**
+ * Profiling probes, i.e. the instrumented parts of the hot path.
+ */
+enum FourWireFanProbe : uint8_t {
+    FOURWIREFAN_PROBE_COUNT = 0,    // `count()`, i.e. the tach ISR
+    FOURWIREFAN_PROBE_UPDATE = 1,   // `update()` of a fan (or of a whole `FourWireFanArray`)
+    FOURWIREFAN_PROBE_SETPWM = 2,   // `setPWM()`, `setDuty()` or `setRPM()` (the set point, it's output by `update()`)
+    FOURWIREFAN_PROBE_CRITICAL = 3, // the sampling critical section of `update()`, i.e. how long tach interrupts are held off
+    FOURWIREFAN_PROBES = 4
+};
+
+#if FOURWIREFAN_PROFILE
+#define FOURWIREFAN_PROFILE_BEGIN(name) uint32_t _profile_##name = FOURWIREFAN_PROFILE_CLOCK()
+#define FOURWIREFAN_PROFILE_END(name, probe) FourWireFanProfile::record(probe, FOURWIREFAN_PROFILE_CLOCK() - _profile_##name)
+#else
+#define FOURWIREFAN_PROFILE_BEGIN(name)                 // compiled out
+#define FOURWIREFAN_PROFILE_END(name, probe)            // compiled out
+#endif
+
+/**
+ * Opt-in profiling of the hot path: the number of calls, the mean and the maximum cost of each probe (see `FourWireFanProbe`).
+ *
+ * The probes are compiled in with `-D FOURWIREFAN_PROFILE=1` only, otherwise they don't cost a single cycle.
+ * They read `FOURWIREFAN_PROFILE_CLOCK()` on entry and exit; the cost of an empty probe is measured by `reset()` and deducted.
+ * The mean is accurate to well below the clock's resolution (given enough calls), the maximum is not.
+ *
+ * A tach edge waits for at most the longest critical section plus the ISRs of all other fans (see `getLatency()`).
+ */
+class FourWireFanProfile {
+    public:
+        static void record(uint8_t probe, uint32_t ticks);          // Records a call of a probe (see `FOURWIREFAN_PROFILE_END`)
+        static void reset();                                        // Clears all probes (and measures the cost of an empty probe)
+
+        static uint32_t getCalls(uint8_t probe);                    // Returns the number of calls of a probe
+        static uint32_t getMean(uint8_t probe);                     // Returns the mean cost of a probe (in ns)
+        static uint32_t getMax(uint8_t probe);                      // Returns the maximum cost of a probe (in ns)
+        static uint32_t getLatency(uint8_t fans);                   // Returns the worst case tach interrupt latency (in ns)
+
+    protected:
+        static volatile uint32_t _calls[FOURWIREFAN_PROBES];        // the number of calls per probe
+        static volatile uint32_t _total[FOURWIREFAN_PROBES];        // the total cost per probe (in ticks)
+        static volatile uint32_t _max[FOURWIREFAN_PROBES];          // the maximum cost per probe (in ticks)
+        static uint32_t _overhead;                                  // the cost of an empty probe (in ticks)
+
+        static uint32_t toNanos(uint64_t ticks);                    // converts clock ticks to ns
+};
+
+#endif  // __FOURWIREFANPROFILE_H__
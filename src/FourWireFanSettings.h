@@ -13,6 +13,32 @@
 
 #include "Arduino.h"
 
+class FourWireFanTach;
+
+/**
+ * Tachometer measurement methods.
+ */
+enum FourWireFanMethod : uint8_t {
+    FOURWIREFAN_COUNTING = 0,  // count pulses within the update period (default)
+    FOURWIREFAN_PERIOD = 1     // average the intervals between the most recent tach edges
+};
+
+/**
+ * Tachometer input filters (i.e. the way edges are debounced).
+ */
+enum FourWireFanFilter : uint8_t {
+    FOURWIREFAN_FIXED = 0,     // ignore edges within the debounce timeout `tau` after a counted one (default)
+    FOURWIREFAN_ADAPTIVE = 1   // ignore edges within three quarters of the running pulse period, or within half a pulse period at `maxRPM` (`tau` is ignored)
+};
+
+/**
+ * PWM outputs.
+ */
+enum FourWireFanOutput : uint8_t {
+    FOURWIREFAN_ANALOGWRITE = 0, // `analogWrite()`, i.e. 8 bit at about 490 Hz or 980 Hz (default)
+    FOURWIREFAN_25KHZ = 1        // 16 bit timer in phase correct mode at 25 kHz (falls back to `analogWrite()` on other pins)
+};
+
 /**
  * Connection settings of a four wire fan. 
  * These settings inform the driver about the electrical connection of a fan. 
@@ -26,6 +52,11 @@ class FourWireFanSettings {
         uint8_t tachMode;      // Tachometer interrupt mode
         uint8_t tachPU;        // Pull up tach pin internally?
         uint32_t tau;          // The debounce timeout
+        uint8_t method;        // The tachometer measurement method
+        FourWireFanTach* tach; // The tachometer input (none: external interrupt via `tachISR`)
+        uint8_t output;        // The PWM output
+        uint8_t filter;        // The tachometer input filter
+        uint16_t stretch;      // The tach window of a three wire fan, i.e. full duty while measuring (in ms, 0: four wire fan)
 
         /**
          * Constructs a new four wire fan settings instance.
@@ -36,14 +67,24 @@ class FourWireFanSettings {
          * @param tachMode     Tachometer interrupt pin mode (default: rising)
          * @param tachPU       Pull-up tach pin internally? (default: no)    
          * @param tau          debounce timeout (default: 10000)
+         * @param method       tachometer measurement method (default: pulse counting)
+         * @param tach         tachometer input, e.g. a hardware counter (default: external interrupt via `tachISR`)
+         * @param output       PWM output (default: `analogWrite()`)
+         * @param filter       tachometer input filter (default: fixed debounce timeout)
+         * @param stretch      tach window of a three wire fan, i.e. pulse stretching (in ms, a few pulses at the lowest speed, default: none, i.e. a four wire fan)
          */
-        FourWireFanSettings(uint8_t pwmPin = 3, uint8_t tachPin = 2, void (*tachISR)(void) = nullptr, uint8_t tachMode = FALLING, uint8_t tachPU = INPUT_PULLUP, uint32_t tau = 10000L): 
+        FourWireFanSettings(uint8_t pwmPin = 3, uint8_t tachPin = 2, void (*tachISR)(void) = nullptr, uint8_t tachMode = FALLING, uint8_t tachPU = INPUT_PULLUP, uint32_t tau = 10000L, uint8_t method = FOURWIREFAN_COUNTING, FourWireFanTach* tach = nullptr, uint8_t output = FOURWIREFAN_ANALOGWRITE, uint8_t filter = FOURWIREFAN_FIXED, uint16_t stretch = 0): 
             pwmPin(pwmPin), 
             tachPin(tachPin),
             tachISR(tachISR),
             tachMode(tachMode),
             tachPU(tachPU),
-            tau(tau)
+            tau(tau),
+            method(method),
+            tach(tach),
+            output(output),
+            filter(filter),
+            stretch(stretch)
         { /* nop */ }
 };
 
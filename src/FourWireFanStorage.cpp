@@ -0,0 +1,198 @@
+/**
+ * Four Wire Fan
+ *
+ * Persistent fan models in EEPROM.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "Arduino.h"
+#include "FourWireFanStorage.h"  // https://github.com/sekdiy/FourWireFan
+
+#if defined(E2END)                                  // AVR (or simulated) EEPROM
+#include <EEPROM.h>
+
+/**
+ * Restores a fan's model and debounce timeout from a slot.
+ *
+ * The record is copied into the fan's current model, so each fan should have a model of its own (as for calibration).
+ * Without a valid record (e.g. on first boot), the fan is left as is.
+ *
+ * @since 2026-10-16
+ *
+ * @param slot The slot
+ * @param fan The fan
+ *
+ * @return bool Whether there was a valid record
+ */
+bool FourWireFanStorage::load(uint8_t slot, FourWireFan* fan)
+{
+    FourWireFanModel* model = fan->getModel();
+    uint32_t tau;
+
+    if (!this->read(slot, model, &tau)) {
+        return false;
+    }
+
+    fan->setModel(model);                           // (rebuilds the lookup table)
+    fan->setDebounceTime(tau);
+
+    return true;
+}
+
+/**
+ * Stores a fan's model and debounce timeout in a slot (e.g. after calibration).
+ *
+ * @since 2026-10-16
+ *
+ * @param slot The slot
+ * @param fan The fan
+ *
+ * @return uint8_t The number of bytes written (0: unchanged or no such slot)
+ */
+uint8_t FourWireFanStorage::save(uint8_t slot, FourWireFan* fan)
+{
+    return this->write(slot, fan->getModel(), fan->getDebounceTime());
+}
+
+/**
+ * Reads a record into a model, if its version, CRC and limits are valid (otherwise the model is left as is).
+ *
+ * @since 2026-10-16
+ *
+ * @param slot The slot
+ * @param model The model to restore
+ * @param tau The debounce timeout to restore (in µs, optional)
+ *
+ * @return bool Whether the record was valid
+ */
+bool FourWireFanStorage::read(uint8_t slot, FourWireFanModel* model, uint32_t* tau)
+{
+    uint8_t record[FOURWIREFAN_RECORD_SIZE];
+    uint16_t address = this->_address + slot * FOURWIREFAN_RECORD_SIZE;
+
+    if (slot >= this->getSlots()) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < FOURWIREFAN_RECORD_SIZE; i++) {
+        record[i] = EEPROM.read(address + i);
+    }
+
+    uint16_t crc = record[FOURWIREFAN_RECORD_SIZE - 2] | (uint16_t) record[FOURWIREFAN_RECORD_SIZE - 1] << 8;
+
+    if ((FOURWIREFAN_RECORD_VERSION != record[0]) || (FourWireFan::crc16(record, FOURWIREFAN_RECORD_SIZE - 2) != crc)) {
+        return false;                               // blank, damaged, or another format
+    }
+
+    if ((record[4] > 100) || (record[1] >= record[4]) || (0 == record[9])) {
+        return false;                               // out of bounds (see `FourWireFan::setModel()`)
+    }
+
+    model->minPWM = record[1];
+    model->minRPM = record[2] | (uint16_t) record[3] << 8;
+    model->maxPWM = record[4];
+    model->maxRPM = record[5] | (uint16_t) record[6] << 8;
+    model->spinup = record[7] | (uint16_t) record[8] << 8;
+    model->ppr = record[9];
+
+    for (uint8_t i = 0; i < 10; i++) {
+        model->refRPM[i] = record[12 + 2 * i] | (uint16_t) record[13 + 2 * i] << 8;
+    }
+
+    model->prepare();
+
+    if (tau) {
+        *tau = record[10] | (uint16_t) record[11] << 8;
+    }
+
+    return true;
+}
+
+/**
+ * Writes a record, i.e. only the bytes that differ from the stored ones (sparing the EEPROM cells).
+ *
+ * @since 2026-10-16
+ *
+ * @param slot The slot
+ * @param model The model to store
+ * @param tau The debounce timeout to store (in µs, up to 65535)
+ *
+ * @return uint8_t The number of bytes written (0: unchanged or no such slot)
+ */
+uint8_t FourWireFanStorage::write(uint8_t slot, FourWireFanModel* model, uint32_t tau)
+{
+    uint8_t record[FOURWIREFAN_RECORD_SIZE];
+    uint16_t address = this->_address + slot * FOURWIREFAN_RECORD_SIZE;
+    uint8_t written = 0;
+
+    if (slot >= this->getSlots()) {
+        return 0;
+    }
+
+    this->encode(record, model, tau);
+
+    for (uint8_t i = 0; i < FOURWIREFAN_RECORD_SIZE; i++) {
+        if (EEPROM.read(address + i) != record[i]) {
+            EEPROM.write(address + i, record[i]);
+            written++;
+        }
+    }
+
+    return written;
+}
+
+/**
+ * Returns the number of slots that fit into the EEPROM (from the first slot's address on).
+ *
+ * @since 2026-10-16
+ *
+ * @return uint8_t
+ */
+uint8_t FourWireFanStorage::getSlots()
+{
+    uint16_t size = E2END + 1;
+
+    return (this->_address < size) ? min((size - this->_address) / FOURWIREFAN_RECORD_SIZE, 255) : 0;
+}
+
+/**
+ * Serialises a model and a debounce timeout into a record (with version and CRC).
+ *
+ * @since 2026-10-16
+ *
+ * @param record The record (`FOURWIREFAN_RECORD_SIZE` bytes)
+ * @param model The model
+ * @param tau The debounce timeout (in µs, up to 65535)
+ */
+void FourWireFanStorage::encode(uint8_t* record, FourWireFanModel* model, uint32_t tau)
+{
+    uint16_t timeout = min(tau, 65535UL);
+
+    record[0] = FOURWIREFAN_RECORD_VERSION;
+    record[1] = model->minPWM;
+    record[2] = model->minRPM & 0xFF;
+    record[3] = model->minRPM >> 8;
+    record[4] = model->maxPWM;
+    record[5] = model->maxRPM & 0xFF;
+    record[6] = model->maxRPM >> 8;
+    record[7] = model->spinup & 0xFF;
+    record[8] = model->spinup >> 8;
+    record[9] = model->ppr;
+    record[10] = timeout & 0xFF;
+    record[11] = timeout >> 8;
+
+    for (uint8_t i = 0; i < 10; i++) {
+        record[12 + 2 * i] = model->refRPM[i] & 0xFF;
+        record[13 + 2 * i] = model->refRPM[i] >> 8;
+    }
+
+    uint16_t crc = FourWireFan::crc16(record, FOURWIREFAN_RECORD_SIZE - 2);
+
+    record[FOURWIREFAN_RECORD_SIZE - 2] = crc & 0xFF;
+    record[FOURWIREFAN_RECORD_SIZE - 1] = crc >> 8;
+}
+
+#endif  // E2END
@@ -0,0 +1,57 @@
+/**
+ * Four Wire Fan
+ *
+ * An Arduino four-wire fan library that provides a PWM speed and tachometer interface.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef __FOURWIREFANSTORAGE_H__
+#define __FOURWIREFANSTORAGE_H__
+
+#include "FourWireFan.h"
+
+#define FOURWIREFAN_RECORD_VERSION 1                    // the record format (records of any other version are ignored)
+#define FOURWIREFAN_RECORD_SIZE 34                      // the size of a record (in bytes)
+
+/**
+ * Persistent fan models in EEPROM, one record per slot (e.g. per fan of an array), so calibration results survive a reset.
+ *
+ * A record holds the model (limits, spin-up, pulses per revolution and speed reference values) and the debounce timeout,
+ * in little endian and followed by a CRC-16 (see `FourWireFan::crc16()`):
+ *
+ *     version (uint8_t), minPWM (uint8_t), minRPM (uint16_t), maxPWM (uint8_t), maxRPM (uint16_t), spinup (uint16_t),
+ *     ppr (uint8_t), tau (uint16_t, in µs), refRPM (10 × uint16_t), CRC (uint16_t)
+ *
+ * Nothing is read until a record is loaded. A record is only restored if its version, CRC and limits are valid, otherwise
+ * the fan keeps its model (e.g. on first boot). Saving only writes the bytes that differ, so an unchanged record costs no wear.
+ * This requires the AVR `EEPROM` library (i.e. a microcontroller with `E2END`).
+ */
+class FourWireFanStorage {
+    public:
+        /**
+         * Constructs a new storage for fan models.
+         *
+         * @param address The EEPROM address of the first slot (default: 0)
+         */
+        FourWireFanStorage(uint16_t address = 0) :
+            _address(address)
+        { /* nop */ }
+
+        bool load(uint8_t slot, FourWireFan* fan);                  // Restores a fan's model and debounce timeout from a slot, returns whether there was a valid record
+        uint8_t save(uint8_t slot, FourWireFan* fan);               // Stores a fan's model and debounce timeout in a slot, returns the number of bytes written
+
+        bool read(uint8_t slot, FourWireFanModel* model, uint32_t* tau = nullptr); // Reads a record into a model (if valid)
+        uint8_t write(uint8_t slot, FourWireFanModel* model, uint32_t tau); // Writes a record (changed bytes only)
+
+        uint8_t getSlots();                                         // Returns the number of slots that fit into the EEPROM
+
+    protected:
+        uint16_t _address;                                          // the EEPROM address of the first slot
+
+        void encode(uint8_t* record, FourWireFanModel* model, uint32_t tau); // serialises a model (with version and CRC)
+};
+
+#endif  // __FOURWIREFANSTORAGE_H__
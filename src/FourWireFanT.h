@@ -0,0 +1,190 @@
+/**
+ * Four Wire Fan
+ *
+ * An Arduino four-wire fan library that provides a PWM speed and tachometer interface.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef __FOURWIREFANT_H__
+#define __FOURWIREFANT_H__
+
+#include "FourWireFan.h"
+
+/**
+ * A four-wire fan driver whose connection and model are fixed at compile time.
+ *
+ * Pins, debounce timeout and model are template parameters, so there are no settings or model pointers to follow,
+ * the fan model stays in flash (see `FourWireFanConstModel`) and nothing is allocated on the heap.
+ * The state is static, i.e. there's exactly one fan per tach pin, and it comes with its own interrupt service routine.
+ * Speed is measured by pulse counting. For anything configured at runtime, use `FourWireFan` instead.
+ *
+ * The interrupt is still attached via `attachInterrupt()` and edges are still timed by `micros()` (for debouncing),
+ * so the savings per edge are the pointer dereferences, not the core's interrupt dispatch.
+ * Likewise, only 25 kHz PWM (`FOURWIREFAN_25KHZ`) is a single register write, any other output goes through `analogWrite()`.
+ *
+ * @param PwmPin   The output pin where the fan's PWM signal input is connected
+ * @param TachPin  The input pin where the fan's tachometer signal output pin is connected
+ * @param Model    The properties of the fan (default: generic four wire fan)
+ * @param Tau      The debounce timeout (in µs, default: 10000)
+ * @param TachMode The tachometer interrupt mode (default: falling)
+ * @param TachPU   The tachometer pin mode (default: internal pull-up)
+ * @param Output   The PWM output (default: `analogWrite()`)
+ */
+template <uint8_t PwmPin, uint8_t TachPin, typename Model = DefaultFourWireFanConstModel, uint32_t Tau = 10000L, uint8_t TachMode = FALLING, uint8_t TachPU = INPUT_PULLUP, uint8_t Output = FOURWIREFAN_ANALOGWRITE>
+class FourWireFanT {
+    public:
+        void begin() {                              // Setup physical connection and clear pulse counter
+            if (FOURWIREFAN_25KHZ == Output) {
+                FourWireFan::setupTimer(PwmPin);
+                FourWireFanT::write(_state.duty);  // output the current set point…
+                pinMode(PwmPin, OUTPUT);            // …before driving the pin
+            }
+
+            pinMode(TachPin, TachPU);
+
+            noInterrupts();                         // going to change interrupt variable(s)
+            attachInterrupt(digitalPinToInterrupt(TachPin), &FourWireFanT::count, TachMode);
+            interrupts();                           // never forget!
+
+            this->reset();
+        }
+
+        void reset() {                              // Resets measurement values (only)
+            noInterrupts();
+            _state.tach.reset();
+            _state.sample.now = micros();
+            interrupts();
+
+            _state.spinup = 0;
+            _state.rpm = 0;
+        }
+
+        static void count() {                       // Increments the pulse counter (the interrupt service routine)
+            _state.tach.count(Tau);
+        }
+
+        void update(uint16_t duration = 1000);      // Updates fan speed from tachometer pulse input
+
+        bool poll(uint16_t period = 1000) {         // Updates fan speed if a measuring period has passed (non-blocking)
+            if (micros() - _state.sample.now < period * 1000UL) {
+                return false;                       // not due yet
+            }
+
+            this->update(FOURWIREFAN_ELAPSED);
+
+            return true;
+        }
+
+        uint32_t getRPM() { return _state.rpm; }   // Returns calculated RPM (i.e. fan speed)
+        uint32_t getElapsed() { return _state.sample.elapsed; } // Returns actual length of the most recent measuring period (in µs)
+
+        FourWireFanT* setRPM(uint32_t rpm) {        // Updates PWM (duty cycle) according to RPM via fan model lookup
+            return this->setPWM(Model::toPWM(min(rpm, 65535UL)));
+        }
+
+        uint8_t getPWM() { return _state.pwm; }    // Returns current PWM set point
+
+        FourWireFanT* setPWM(uint8_t pwm) {         // Updates PWM set point
+            return this->setDuty(FourWireFan::toDuty(pwm));
+        }
+
+        uint16_t getDuty() { return _state.duty; } // Returns current duty cycle set point (in 1/65535)
+
+        FourWireFanT* setDuty(uint16_t duty) {      // Updates duty cycle set point (in 1/65535)
+            _state.duty = max(FourWireFan::toDuty(Model::minPWM), min(FourWireFan::toDuty(Model::maxPWM), duty)); // minPWM <= duty <= maxPWM
+            _state.pwm = ((uint32_t) _state.duty * 100 + 32767) / 65535; // in percent (rounded)
+
+            return this;
+        }
+
+        bool isBlocked() { return (0 < _state.spinup); } // Shows indication of spindown condition
+
+    protected:
+        struct State {                              // all of the fan's RAM (one instance per fan type)
+            FourWireFanInterruptTach tach;          // the tachometer input (external interrupt)
+            FourWireFanSample sample;               // the most recent snapshot of the tachometer input
+            uint32_t rpm = 0;                       // the calculated RPM (i.e. fan speed)
+            uint16_t duty = 0xFFFF;                 // the set point for PWM output pin (in 1/65535, default: 100%)
+            uint8_t pwm = 255;                      // the set point for PWM output pin (in percent)
+            int16_t spinup = 0;                     // the spinup condition counter
+        };
+
+        static State _state;                        // the fan's state
+
+        static void write(uint16_t duty);           // sets PWM output pin duty cycle (in 1/65535)
+};
+
+template <uint8_t P, uint8_t T, typename M, uint32_t U, uint8_t D, uint8_t R, uint8_t O> typename FourWireFanT<P, T, M, U, D, R, O>::State FourWireFanT<P, T, M, U, D, R, O>::_state;
+
+/**
+ * Updates fan operation, e.g. spinning up, tachometer input, speed update, spindown detection.
+ *
+ * This is `FourWireFan::update()` with all properties known at compile time, see there.
+ *
+ * @param duration The length of the measuring period since the last call to `update()` (in ms, or 0 to measure it)
+ */
+template <uint8_t PwmPin, uint8_t TachPin, typename Model, uint32_t Tau, uint8_t TachMode, uint8_t TachPU, uint8_t Output>
+void FourWireFanT<PwmPin, TachPin, Model, Tau, TachMode, TachPU, Output>::update(uint16_t duration)
+{
+    uint32_t now = micros();
+
+    /* sample tachometer value */
+    noInterrupts();                                 // going to change interrupt variables
+    _state.sample.elapsed = now - _state.sample.now;
+    _state.sample.now = now;
+    _state.tach.sample(&_state.sample);             // not virtual here: the type is known
+    interrupts();                                   // never forget!
+
+    uint32_t elapsed = duration ? duration * 1000UL : _state.sample.elapsed;
+    uint16_t targetDuty = FourWireFan::toDuty(Model::maxPWM); // default to maximum fan speed (as a safety measure!)
+
+    _state.rpm = FourWireFan::pulsesToRPM(_state.sample.pulses, elapsed, Model::ppr);
+
+    /* detect spindown (only if one more pulse wouldn't have made a difference, or if there's none) */
+    if (((0 == _state.rpm) || (_state.rpm + FourWireFan::pulsesToRPM(1, elapsed, Model::ppr) <= Model::minRPM)) && (_state.pwm >= Model::minPWM)) {
+        _state.spinup = Model::spinup;
+    }
+
+    /* handle spinup */
+    if (0 < _state.spinup) {
+        if (_state.rpm >= Model::minRPM) {
+            _state.spinup -= elapsed / 1000;
+        }
+    } else {
+        targetDuty = _state.duty;
+    }
+
+    /* update speed set point */
+    FourWireFanT::write(targetDuty);
+}
+
+/**
+ * Sets the PWM output pin duty cycle, i.e. a single register write for timer PWM.
+ *
+ * @param duty The duty cycle (in 1/65535)
+ */
+template <uint8_t PwmPin, uint8_t TachPin, typename Model, uint32_t Tau, uint8_t TachMode, uint8_t TachPU, uint8_t Output>
+void FourWireFanT<PwmPin, TachPin, Model, Tau, TachMode, TachPU, Output>::write(uint16_t duty)
+{
+#if defined(__AVR_ATmega32U4__) || defined(__AVR_ATmega328P__)
+    if (FOURWIREFAN_25KHZ == Output) {
+        uint16_t value = ((uint32_t) duty * FOURWIREFAN_PWM_TOP + 0x8000UL) >> 16; // 1/65535 to TOP (rounded)
+
+        switch (PwmPin) {                           // resolved at compile time
+            case 9: OCR1A = value; return;
+            case 10: OCR1B = value; return;
+#if defined(__AVR_ATmega32U4__)
+            case 11: OCR1C = value; return;
+            case 5: OCR3A = value; return;
+#endif
+        }
+    }
+#endif
+
+    analogWrite(PwmPin, FourWireFan::toAnalog(duty));   // 1/65535 to 8 bit (rounded)
+}
+
+#endif  // __FOURWIREFANT_H__
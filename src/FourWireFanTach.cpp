@@ -0,0 +1,135 @@
+/**
+ * Four Wire Fan
+ *
+ * Tachometer inputs of a four wire fan.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "Arduino.h"
+#include "FourWireFanTach.h"
+#include "FourWireFanSettings.h"
+
+/**
+ * Sets up the tachometer input: pin mode and interrupt service routine.
+ *
+ * @since 2020-07-22
+ *
+ * @param settings The connection settings of the fan
+ */
+void FourWireFanInterruptTach::begin(FourWireFanSettings* settings)
+{
+    pinMode(settings->tachPin, settings->tachPU);
+
+    noInterrupts();                                 // going to change interrupt variable(s)
+    attachInterrupt(digitalPinToInterrupt(settings->tachPin), settings->tachISR, settings->tachMode);
+    interrupts();                                   // never forget!
+}
+
+/**
+ * Clears the pulse counter and any recorded edges (with interrupts disabled).
+ *
+ * @since 2020-07-22
+ */
+void FourWireFanInterruptTach::reset()
+{
+    this->_taken = this->_pulses;                   // restart counting from here
+    this->_rejected = this->_glitches;
+    this->_stored = 0;                              // forget recorded tach edges (so the next one isn't debounced)
+    this->_period = 0;                              // forget tracked pulse period
+    this->_skipped = false;
+    this->_skipping = 0;
+    this->_triggered = false;                       // (the next edge starts a new edge span)
+}
+
+/**
+ * Takes a snapshot of the pulse counter and the recorded edges (with interrupts disabled).
+ *
+ * The pulses of this measuring period are the difference to the counter at the previous sample.
+ * The counter itself keeps running, so every edge is counted in exactly one period, and debouncing carries over, too.
+ * Likewise, the edge span runs from the most recent edge of the previous sample to the most recent edge of this one,
+ * so consecutive edge spans neither overlap nor leave gaps.
+ *
+ * @since 2026-10-16
+ *
+ * @param sample The snapshot to fill in (with `now` already set)
+ */
+void FourWireFanInterruptTach::sample(FourWireFanSample* sample)
+{
+    uint32_t pulses = this->_pulses;                // consistent reads (interrupts are disabled)
+    uint16_t glitches = this->_glitches;
+
+    sample->pulses = pulses - this->_taken;         // save pulses counted during duration…
+    sample->glitches = glitches - this->_rejected;  // …and edges rejected
+    this->_taken = pulses;
+    this->_rejected = glitches;
+    sample->stored = this->_stored;                 // save number of recorded edges…
+    sample->newest = this->_edges[(this->_edge + FOURWIREFAN_EDGES - 1) % FOURWIREFAN_EDGES];              // …the most recent one…
+    sample->oldest = this->_edges[(this->_edge + FOURWIREFAN_EDGES - sample->stored) % FOURWIREFAN_EDGES]; // …and the oldest one
+    sample->intervals = sample->stored ? pulses - this->_anchored : 0; // save the edge intervals since the anchor edge…
+    sample->span = sample->stored ? sample->newest - this->_anchor : 0; // …and their span
+    this->_anchor = sample->newest;                 // the next edge span starts at the most recent edge
+    this->_anchored = pulses;
+    this->_triggered = false;
+    if (sample->stored && (sample->now - sample->newest > 1000000L)) {
+        this->_stored = 0;                          // drop stale edges (i.e. fan at standstill)…
+        this->_period = 0;                          // …and start tracking anew
+        this->_skipping = 0;
+    }
+}
+
+#ifdef FOURWIREFAN_T1_PIN
+
+/**
+ * Sets up the tachometer input: Timer1 in normal mode, clocked by the T1 pin.
+ *
+ * @since 2026-10-16
+ *
+ * @param settings The connection settings of the fan (tach mode and pull-up)
+ */
+void FourWireFanTimerTach::begin(FourWireFanSettings* settings)
+{
+    pinMode(FOURWIREFAN_T1_PIN, settings->tachPU);
+
+    noInterrupts();                                 // going to change timer registers
+    TCCR1A = 0;                                     // normal mode, no output compare
+    TCCR1B = (RISING == settings->tachMode) ? (_BV(CS12) | _BV(CS11) | _BV(CS10)) : (_BV(CS12) | _BV(CS11)); // external clock on T1
+    TCNT1 = 0;
+    this->_last = 0;
+    interrupts();                                   // never forget!
+}
+
+/**
+ * Clears the pulse counter (with interrupts disabled).
+ *
+ * @since 2026-10-16
+ */
+void FourWireFanTimerTach::reset()
+{
+    this->_last = TCNT1;
+}
+
+/**
+ * Takes a snapshot of the hardware counter (with interrupts disabled).
+ *
+ * The counter keeps running, so no pulse gets lost between two samples (as long as there are less than 65536).
+ *
+ * @since 2026-10-16
+ *
+ * @param sample The snapshot to fill in (with `now` already set)
+ */
+void FourWireFanTimerTach::sample(FourWireFanSample* sample)
+{
+    uint16_t counter = TCNT1;                       // one (16 bit) register read
+
+    sample->pulses = (uint16_t) (counter - this->_last);
+    sample->glitches = 0;                           // no filter
+    sample->stored = 0;                             // no edge moments…
+    sample->intervals = 0;                          // …thus no edge span
+    sample->span = 0;
+    this->_last = counter;
+}
+
+#endif
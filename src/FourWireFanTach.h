@@ -0,0 +1,190 @@
+/**
+ * Four Wire Fan
+ *
+ * An Arduino four-wire fan library that provides a PWM speed and tachometer interface.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef __FOURWIREFANTACH_H__
+#define __FOURWIREFANTACH_H__
+
+#include "Arduino.h"
+
+#ifndef FOURWIREFAN_EDGES
+#define FOURWIREFAN_EDGES 4                             // number of tach edge timestamps kept for period measurement
+#endif
+
+#ifndef FOURWIREFAN_RELOCK
+#define FOURWIREFAN_RELOCK 8                            // consecutive counted edges each preceded by a rejected one until the adaptive filter relocks
+#endif
+
+class FourWireFanSettings;
+
+/**
+ * A snapshot of the tachometer input, taken at the end of a measuring period.
+ */
+struct FourWireFanSample {
+    uint32_t now;                                       // the moment of sampling
+    uint32_t elapsed;                                   // the actual length of the measuring period
+    uint32_t window;                                    // the length of the tach window within it (three wire fan only, otherwise 0)
+    uint32_t pulses;                                    // the pulses within the measuring period
+    uint16_t glitches;                                  // the edges rejected (debounced) within the measuring period
+    uint32_t newest;                                    // the moment of the most recent tach edge
+    uint32_t oldest;                                    // the moment of the oldest recorded tach edge
+    uint8_t stored;                                     // the number of recorded tach edges
+    uint32_t span;                                      // the time from the last tach edge of the previous period to the most recent one (edge span)
+    uint32_t intervals;                                 // the tach edge intervals within the edge span (none: no edge span)
+};
+
+/**
+ * A tachometer input, i.e. the way tach pulses are counted (or timed).
+ */
+class FourWireFanTach {
+    public:
+        virtual ~FourWireFanTach() {}
+        virtual void begin(FourWireFanSettings* settings) = 0; // Sets up the tachometer input
+        virtual void reset() = 0;                              // Clears the pulse counter (with interrupts disabled)
+        virtual void sample(FourWireFanSample* sample) = 0;    // Takes a snapshot and restarts counting (with interrupts disabled)
+        virtual bool hasEdges() { return false; }              // Shows whether edge moments are recorded (for period measurement)
+};
+
+/**
+ * Tachometer input via an external interrupt (one ISR entry per tach edge, debounced in software).
+ *
+ * This is the default tachometer input of every fan, see `FourWireFan::count()`.
+ */
+class FourWireFanInterruptTach : public FourWireFanTach {
+    public:
+        void begin(FourWireFanSettings* settings);
+        void reset();
+        void sample(FourWireFanSample* sample);
+        bool hasEdges() { return true; }
+
+        /**
+         * Counts a tach edge and records its moment, unless it's a bounce or glitch (called from the ISR).
+         *
+         * With a fixed filter, edges within `tau` after the previous counted one are rejected.
+         * The adaptive filter tracks the pulse period instead and rejects edges within three quarters of it (but at least `tau`),
+         * so accepted glitches can't shrink the tracked period far enough to let the next one through.
+         * An isolated glitch thus either gets rejected, or takes the place of the next actual edge (which then gets rejected).
+         * An implausibly long interval (more than four pulse periods, e.g. after a missed edge) is rejected as well: it's counted
+         * as a glitch and left out of the edge span (the edge itself is still counted), then tracking starts anew.
+         * After a fast speed step, every other edge may fall within three quarters of the (outdated) tracked period, i.e. the filter
+         * would lock onto a multiple of the pulse period. So once `FOURWIREFAN_RELOCK` counted edges in a row each followed a
+         * rejected one, the tracked period is halved (isolated glitches hardly ever line up like that).
+         * The ISR is the only writer of the counters, which keep running across samples (see `sample()`).
+         * With a trigger, the edge that completes that many intervals since the previous sample raises the trigger flag.
+         *
+         * @param tau The debounce timeout (in µs)
+         * @param adaptive Whether to use the adaptive filter (`tau` is its minimum then)
+         * @param trigger The number of tach edge intervals to raise the trigger flag at (none: no trigger)
+         *
+         * @return bool Whether this edge has raised the trigger flag
+         */
+        inline bool count(uint32_t tau, bool adaptive = false, uint8_t trigger = 0) {
+            uint32_t now = micros();
+
+            if (this->_stored) {
+                uint32_t interval = now - this->_edges[(this->_edge + FOURWIREFAN_EDGES - 1) % FOURWIREFAN_EDGES];
+
+                // debouncing (optional, if interval since the previous edge is shorter than debounce timeout)
+                if (interval < (adaptive ? max(tau, this->_period - (this->_period >> 2)) : tau)) {
+                    this->_glitches++;
+                    this->_skipped = true;
+                    return false;
+                }
+
+                // tracking the pulse period (adaptive filter only)
+                if (adaptive) {
+                    this->_skipping = this->_skipped ? this->_skipping + 1 : 0;
+                    this->_skipped = false;
+
+                    if (this->_skipping >= FOURWIREFAN_RELOCK) {
+                        this->_skipping = 0;        // locked onto a multiple of the pulse period: relock
+                        this->_period >>= 1;
+                    } else if (this->_period && (interval > (this->_period << 2))) {
+                        this->_glitches++;          // implausibly long (e.g. a missed edge): reject the interval…
+                        this->_stored = 0;          // …i.e. this edge starts a new edge span…
+                        this->_period = 0;          // …and tracking starts anew
+                    } else if (!this->_period) {
+                        this->_period = interval;   // start
+                    } else {
+                        this->_period = this->_period - (this->_period >> 2) + (interval >> 2);
+                    }
+                }
+            }
+
+            this->_pulses++;
+
+            // the edge span starts at the first edge after a reset (otherwise at the most recent edge of the previous sample)
+            if (!this->_stored) {
+                this->_anchor = now;
+                this->_anchored = this->_pulses;
+            }
+
+            // remember the moment of this edge (for debouncing and period measurement)
+            this->_edges[this->_edge] = now;
+            this->_edge = (this->_edge + 1) % FOURWIREFAN_EDGES;
+            if (this->_stored < FOURWIREFAN_EDGES) {
+                this->_stored++;
+            }
+
+            // enough edges for an update?
+            if (trigger && !this->_triggered && (this->_pulses - this->_anchored >= trigger)) {
+                this->_triggered = true;
+                return true;
+            }
+
+            return false;
+        }
+
+        bool isTriggered() { return this->_triggered; } // Shows whether enough tach edges have arrived since the previous sample
+
+    protected:
+        volatile uint32_t _pulses = 0;                  // the pulses counted so far (free running, written by the ISR only)
+        uint32_t _taken = 0;                            // the pulse counter at the previous sample
+        volatile uint16_t _glitches = 0;                // the rejected edges so far (free running, written by the ISR only)
+        uint16_t _rejected = 0;                         // the rejected edges counter at the previous sample
+        volatile uint32_t _period = 0;                  // the tracked pulse period (adaptive filter only, in µs)
+        volatile uint32_t _edges[FOURWIREFAN_EDGES];    // the moments of the most recent tach edges (ring buffer)
+        volatile uint8_t _edge = 0;                     // the ring buffer position of the next tach edge
+        volatile uint8_t _stored = 0;                   // the number of valid tach edge moments
+        volatile bool _skipped = false;                 // an edge has been rejected since the previous counted one (adaptive filter only)
+        volatile uint8_t _skipping = 0;                 // the counted edges in a row that followed a rejected one (adaptive filter only)
+        volatile uint32_t _anchor = 0;                  // the moment of the tach edge the edge span starts at
+        volatile uint32_t _anchored = 0;                // the pulse counter at that edge
+        volatile bool _triggered = false;               // enough tach edges have arrived since the previous sample (see `count()`)
+};
+
+// Timer1 counting needs its T1 pin, which the Pro Micro doesn't break out (PD6), so it isn't available there
+#if (defined(__AVR_ATmega32U4__) && !defined(ARDUINO_AVR_PROMICRO)) || defined(__AVR_ATmega328P__)
+
+#if defined(__AVR_ATmega32U4__)
+#define FOURWIREFAN_T1_PIN 12                           // T1 (PD6) on Leonardo and Micro
+#else
+#define FOURWIREFAN_T1_PIN 5                            // T1 (PD5) on Uno and Nano
+#endif
+
+/**
+ * Tachometer input via hardware counter: Timer1 clocked by tach edges on its T1 pin (see `FOURWIREFAN_T1_PIN`).
+ *
+ * There's no CPU load per tach edge, just one register read per `update()`.
+ * Note that Timer1 can't be used otherwise (e.g. for PWM on its pins), that there's no software debouncing
+ * (use an RC filter if the tach signal bounces), and that edge moments aren't recorded (i.e. pulse counting only).
+ */
+class FourWireFanTimerTach : public FourWireFanTach {
+    public:
+        void begin(FourWireFanSettings* settings);
+        void reset();
+        void sample(FourWireFanSample* sample);
+
+    protected:
+        uint16_t _last = 0;                             // the counter value at the previous sample
+};
+
+#endif
+
+#endif  // __FOURWIREFANTACH_H__
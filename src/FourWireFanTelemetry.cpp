@@ -0,0 +1,334 @@
+/**
+ * Four Wire Fan
+ *
+ * A compact binary telemetry link for four wire fans.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "Arduino.h"
+#include "FourWireFanTelemetry.h"  // https://github.com/sekdiy/FourWireFan
+#include "FourWireFanMonitor.h"
+
+static_assert(5 + FOURWIREFAN_TELEMETRY_FANS * 6 <= 255, "FOURWIREFAN_TELEMETRY_FANS must be 41 or less (sample payload)");
+static_assert(FOURWIREFAN_TELEMETRY_BUFFER >= 5 + FOURWIREFAN_TELEMETRY_FANS * 6 + 6, "FOURWIREFAN_TELEMETRY_BUFFER must hold a sample of all fans");
+
+/**
+ * Constructs a new telemetry link.
+ *
+ * @since 2026-10-16
+ *
+ * @param stream The stream to use, e.g. `&Serial` (it must implement `availableForWrite()`)
+ */
+FourWireFanTelemetry::FourWireFanTelemetry(Stream* stream) :
+    _stream(stream)
+{
+    /* nop */
+}
+
+/**
+ * Adds a fan to the samples.
+ *
+ * @since 2026-10-16
+ *
+ * @param fan The fan to report
+ * @param monitor Its health monitor (none: reported as healthy)
+ *
+ * @return int8_t The fan's index within samples and commands (or -1 if there's no room for another fan)
+ */
+int8_t FourWireFanTelemetry::add(FourWireFan* fan, FourWireFanMonitor* monitor)
+{
+    if (this->_size >= FOURWIREFAN_TELEMETRY_FANS) {
+        return -1;
+    }
+
+    this->_fans[this->_size] = fan;
+    this->_monitors[this->_size] = monitor;
+
+    return this->_size++;
+}
+
+/**
+ * Queues a sample of all fans, i.e. speed, applied duty cycle, spin-up and health.
+ *
+ * This only encodes the frame into the transmit buffer, see `poll()` for the actual transmission.
+ *
+ * @since 2026-10-16
+ *
+ * @return bool Whether the frame fit into the transmit buffer (otherwise it's dropped)
+ */
+bool FourWireFanTelemetry::send()
+{
+    if (!this->begin(FOURWIREFAN_FRAME_SAMPLE, this->_sequence++, 5 + this->_size * 6)) {
+        return false;
+    }
+
+    uint32_t now = millis();
+
+    this->put16(now);
+    this->put16(now >> 16);
+    this->put(this->_size);
+
+    for (uint8_t i = 0; i < this->_size; i++) {
+        FourWireFan* fan = this->_fans[i];
+        uint8_t health = this->_monitors[i] ? this->_monitors[i]->getHealth() : 0;
+
+        this->put(i);
+        this->put16(min(fan->getRPM(), 65535UL));
+        this->put16(fan->getApplied());
+        this->put((fan->isBlocked() ? FOURWIREFAN_FLAG_SPINUP : 0) | ((health << 4) & FOURWIREFAN_FLAG_HEALTH));
+    }
+
+    this->end();
+
+    return true;
+}
+
+/**
+ * Writes queued bytes as far as the stream has room for them, and handles received commands (non-blocking).
+ *
+ * This should be called frequently, e.g. once per `loop()`. Each command is acknowledged (see `FOURWIREFAN_FRAME_ACK`).
+ *
+ * @since 2026-10-16
+ */
+void FourWireFanTelemetry::poll()
+{
+    /* receive */
+    while (0 < this->_stream->available()) {
+        uint8_t value = this->_stream->read();
+
+        if (0 != value) {
+            if (this->_received < FOURWIREFAN_TELEMETRY_COMMAND) {
+                this->_rx[this->_received++] = value;
+            } else {
+                this->_overflow = true;
+            }
+            continue;
+        }
+
+        /* end of frame: COBS decode (in place) */
+        uint8_t size = 0;
+        uint8_t i = 0;
+        bool valid = !this->_overflow;
+
+        while (valid && (i < this->_received)) {
+            uint8_t code = this->_rx[i++];
+
+            if (i + code - 1 > this->_received) {
+                valid = false;                      // truncated
+                break;
+            }
+            for (uint8_t k = 1; k < code; k++) {
+                this->_rx[size++] = this->_rx[i++];
+            }
+            if ((code < 0xFF) && (i < this->_received)) {
+                this->_rx[size++] = 0;
+            }
+        }
+
+        if (valid && (4 <= size) && (FourWireFan::crc16(this->_rx, size - 2) == (this->_rx[size - 2] | (uint16_t) this->_rx[size - 1] << 8))) {
+            this->execute(this->_rx, size - 2);
+        }
+
+        this->_received = 0;
+        this->_overflow = false;
+    }
+
+    /* transmit */
+    while (this->_length) {
+        uint16_t tail = (this->_head + FOURWIREFAN_TELEMETRY_BUFFER - this->_length) % FOURWIREFAN_TELEMETRY_BUFFER;
+        uint16_t chunk = min(this->_length, (uint16_t) (FOURWIREFAN_TELEMETRY_BUFFER - tail)); // up to the end of the ring
+        int room = this->_stream->availableForWrite();
+
+        if (room <= 0) {
+            break;                                  // never block
+        }
+
+        uint16_t written = this->_stream->write(&this->_tx[tail], min(chunk, (uint16_t) room));
+
+        this->_length -= written;
+
+        if (written < chunk) {
+            break;
+        }
+    }
+}
+
+/**
+ * Returns the number of frames dropped since the last call (i.e. that didn't fit into the transmit buffer).
+ *
+ * @since 2026-10-16
+ *
+ * @return uint16_t
+ */
+uint16_t FourWireFanTelemetry::getDropped()
+{
+    uint16_t dropped = this->_dropped;
+
+    this->_dropped = 0;
+
+    return dropped;
+}
+
+/**
+ * Returns the number of queued bytes (i.e. not written to the stream yet).
+ *
+ * @since 2026-10-16
+ *
+ * @return uint16_t
+ */
+uint16_t FourWireFanTelemetry::getPending()
+{
+    return this->_length;
+}
+
+/**
+ * Starts a frame with a payload of the given size, if its encoding fits into the transmit buffer (otherwise it's dropped).
+ *
+ * @since 2026-10-16
+ *
+ * @param type The frame type (see `FourWireFanFrame`)
+ * @param sequence The sequence number
+ * @param size The size of the payload (in bytes)
+ *
+ * @return bool Whether the frame fits
+ */
+bool FourWireFanTelemetry::begin(uint8_t type, uint8_t sequence, uint8_t size)
+{
+    uint16_t raw = size + 4;                        // type, sequence, payload and CRC
+    uint16_t encoded = raw + raw / 254 + 2;         // COBS overhead (worst case) and delimiter
+
+    if (encoded > FOURWIREFAN_TELEMETRY_BUFFER - this->_length) {
+        this->_dropped++;
+        return false;
+    }
+
+    this->_code = this->_head;
+    this->push(0);                                  // placeholder for the first code byte
+    this->_run = 1;
+    this->_crc = 0xFFFF;
+
+    this->put(type);
+    this->put(sequence);
+
+    return true;
+}
+
+/**
+ * Adds a byte to the current frame.
+ *
+ * @since 2026-10-16
+ *
+ * @param value The byte
+ */
+void FourWireFanTelemetry::put(uint8_t value)
+{
+    this->_crc = FourWireFan::crc16(&value, 1, this->_crc);
+    this->stuff(value);
+}
+
+/**
+ * Adds two bytes to the current frame (little endian).
+ *
+ * @since 2026-10-16
+ *
+ * @param value The value
+ */
+void FourWireFanTelemetry::put16(uint16_t value)
+{
+    this->put(value & 0xFF);
+    this->put(value >> 8);
+}
+
+/**
+ * Completes the current frame, i.e. appends its CRC and the delimiter.
+ *
+ * @since 2026-10-16
+ */
+void FourWireFanTelemetry::end()
+{
+    uint16_t crc = this->_crc;
+
+    this->stuff(crc & 0xFF);
+    this->stuff(crc >> 8);
+
+    this->_tx[this->_code] = this->_run;            // the last code byte
+    this->push(0);                                  // delimiter
+}
+
+/**
+ * COBS encodes a byte into the transmit buffer, i.e. zeros become code bytes pointing to the next zero.
+ *
+ * @since 2026-10-16
+ *
+ * @param value The byte
+ */
+void FourWireFanTelemetry::stuff(uint8_t value)
+{
+    if (0 != value) {
+        this->push(value);
+        this->_run++;
+    }
+
+    if ((0 == value) || (0xFF == this->_run)) {
+        this->_tx[this->_code] = this->_run;        // complete the current block…
+        this->_code = this->_head;                  // …and start another one
+        this->push(0);
+        this->_run = 1;
+    }
+}
+
+/**
+ * Queues a byte (there's always room, see `begin()`).
+ *
+ * @since 2026-10-16
+ *
+ * @param value The byte
+ */
+void FourWireFanTelemetry::push(uint8_t value)
+{
+    this->_tx[this->_head] = value;
+    this->_head = (this->_head + 1) % FOURWIREFAN_TELEMETRY_BUFFER;
+    this->_length++;
+}
+
+/**
+ * Carries out a received (and decoded) frame and acknowledges it.
+ *
+ * @since 2026-10-16
+ *
+ * @param frame The frame (type, sequence and payload)
+ * @param size The size of the frame (without CRC, at least 2)
+ */
+void FourWireFanTelemetry::execute(uint8_t* frame, uint8_t size)
+{
+    uint8_t type = frame[0];                        // (type and sequence are always there)
+    uint8_t status = FOURWIREFAN_UNKNOWN_COMMAND;
+
+    if ((FOURWIREFAN_FRAME_SET_PWM == type) ? (4 == size) : (5 == size)) { // payload only read if it's there
+        uint8_t index = frame[2];
+        uint16_t value = (5 == size) ? frame[3] | (uint16_t) frame[4] << 8 : frame[3];
+
+        status = FOURWIREFAN_OK;
+
+        if (index >= this->_size) {
+            status = FOURWIREFAN_UNKNOWN_FAN;
+        } else if (FOURWIREFAN_FRAME_SET_PWM == type) {
+            this->_fans[index]->setPWM(value);
+        } else if (FOURWIREFAN_FRAME_SET_RPM == type) {
+            this->_fans[index]->setRPM(value);
+        } else if (FOURWIREFAN_FRAME_SET_DUTY == type) {
+            this->_fans[index]->setDuty(value);
+        } else {
+            status = FOURWIREFAN_UNKNOWN_COMMAND;
+        }
+    }
+
+    if (this->begin(FOURWIREFAN_FRAME_ACK, frame[1], 2)) {
+        this->put(type);
+        this->put(status);
+        this->end();
+    }
+}
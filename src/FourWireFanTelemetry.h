@@ -0,0 +1,106 @@
+/**
+ * Four Wire Fan
+ *
+ * An Arduino four-wire fan library that provides a PWM speed and tachometer interface.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef __FOURWIREFANTELEMETRY_H__
+#define __FOURWIREFANTELEMETRY_H__
+
+#include "FourWireFan.h"
+
+class FourWireFanMonitor;
+
+#ifndef FOURWIREFAN_TELEMETRY_FANS
+#define FOURWIREFAN_TELEMETRY_FANS 8                    // maximum number of fans per telemetry link
+#endif
+
+#ifndef FOURWIREFAN_TELEMETRY_BUFFER
+#define FOURWIREFAN_TELEMETRY_BUFFER 128                // transmit buffer size (in bytes, at least one encoded sample frame)
+#endif
+
+#ifndef FOURWIREFAN_TELEMETRY_COMMAND
+#define FOURWIREFAN_TELEMETRY_COMMAND 16                // receive buffer size (in bytes, i.e. the longest encoded command frame)
+#endif
+
+/**
+ * Telemetry frame types (and their payloads, multi-byte values in little endian).
+ */
+enum FourWireFanFrame : uint8_t {
+    FOURWIREFAN_FRAME_SAMPLE = 0x01,   // time (uint32_t, in ms), count (uint8_t), per fan: index (uint8_t), rpm (uint16_t), duty (uint16_t), flags (uint8_t)
+    FOURWIREFAN_FRAME_ACK = 0x02,      // command type (uint8_t), status (uint8_t, see `FourWireFanStatus`), with the command's sequence number
+    FOURWIREFAN_FRAME_SET_PWM = 0x10,  // index (uint8_t), pwm (uint8_t, in %)
+    FOURWIREFAN_FRAME_SET_RPM = 0x11,  // index (uint8_t), rpm (uint16_t)
+    FOURWIREFAN_FRAME_SET_DUTY = 0x12  // index (uint8_t), duty (uint16_t, in 1/65535)
+};
+
+/**
+ * Command results (see `FOURWIREFAN_FRAME_ACK`).
+ */
+enum FourWireFanStatus : uint8_t {
+    FOURWIREFAN_OK = 0,                // done
+    FOURWIREFAN_UNKNOWN_FAN = 1,       // no fan with that index
+    FOURWIREFAN_UNKNOWN_COMMAND = 2    // unknown frame type (or wrong payload length)
+};
+
+#define FOURWIREFAN_FLAG_SPINUP 0x01                    // sample flags: spinning up (see `isBlocked()`)
+#define FOURWIREFAN_FLAG_HEALTH 0xF0                    // sample flags: health condition in the upper four bits (see `FourWireFanHealth`)
+
+/**
+ * A compact binary telemetry link, e.g. over `Serial`: fan samples out, commands in.
+ *
+ * Each frame is `type`, `sequence`, payload and a CRC-16 (CCITT, over all of these, see `FourWireFan::crc16()`), COBS encoded and terminated by a zero byte,
+ * so a receiver can always resynchronise at the next zero. Frames are encoded right into a preallocated transmit buffer
+ * (no `String`, no heap) and written out by `poll()` only as far as the stream's transmit buffer has room, so it never blocks.
+ * If a frame doesn't fit, it's dropped (and counted) instead. See `extras/telemetry` for the host side.
+ */
+class FourWireFanTelemetry {
+    public:
+        /**
+         * Constructs a new telemetry link.
+         *
+         * @param stream The stream to use, e.g. `&Serial` (it must implement `availableForWrite()`)
+         */
+        FourWireFanTelemetry(Stream* stream);
+
+        int8_t add(FourWireFan* fan, FourWireFanMonitor* monitor = nullptr); // Adds a fan (and optionally its health), returns its index (or -1 if full)
+
+        bool send();                                                // Queues a sample of all fans, returns whether it fit into the transmit buffer
+        void poll();                                                // Writes queued bytes as far as there's room and handles received commands (non-blocking)
+
+        uint16_t getDropped();                                      // Returns the number of frames dropped since the last call
+        uint16_t getPending();                                      // Returns the number of queued bytes
+
+    protected:
+        Stream* _stream;                                            // the stream in use
+        FourWireFan* _fans[FOURWIREFAN_TELEMETRY_FANS];             // the reported fans
+        FourWireFanMonitor* _monitors[FOURWIREFAN_TELEMETRY_FANS];  // their health monitors (if any)
+        uint8_t _size = 0;                                          // the number of reported fans
+        uint8_t _sequence = 0;                                      // the sequence number of the next sample frame
+        uint16_t _dropped = 0;                                      // the number of dropped frames (not reported yet)
+
+        uint8_t _tx[FOURWIREFAN_TELEMETRY_BUFFER];                  // the transmit buffer (ring buffer of encoded frames)
+        uint16_t _head = 0;                                         // the next byte to queue
+        uint16_t _length = 0;                                       // the number of queued bytes
+        uint16_t _code = 0;                                         // the position of the current COBS code byte
+        uint8_t _run = 0;                                           // the current COBS code (1 + bytes since the code byte)
+        uint16_t _crc = 0;                                          // the CRC of the current frame
+
+        uint8_t _rx[FOURWIREFAN_TELEMETRY_COMMAND];                 // the receive buffer (a single encoded frame)
+        uint8_t _received = 0;                                      // the number of received bytes (of the current frame)
+        bool _overflow = false;                                     // current frame too long (i.e. ignored)
+
+        bool begin(uint8_t type, uint8_t sequence, uint8_t size);   // starts a frame with a payload of the given size (if it fits)
+        void put(uint8_t value);                                    // adds a byte to the current frame
+        void put16(uint16_t value);                                 // adds two bytes (little endian)
+        void end();                                                 // completes the current frame
+        void stuff(uint8_t value);                                  // COBS encodes a byte into the transmit buffer
+        void push(uint8_t value);                                   // queues a byte
+        void execute(uint8_t* frame, uint8_t size);                 // carries out a received (decoded) frame
+};
+
+#endif  // __FOURWIREFANTELEMETRY_H__
@@ -0,0 +1,246 @@
+/**
+ * Four Wire Fan
+ *
+ * A thermal engine driving four wire fans from temperature zones via fan curves.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "Arduino.h"
+#include "FourWireFanThermal.h"  // https://github.com/sekdiy/FourWireFan
+
+/**
+ * Appends a point to the curve (at a higher temperature than the previous one, otherwise it's ignored).
+ *
+ * @since 2026-10-16
+ *
+ * @param temperature The temperature (in 1/10 °C)
+ * @param pwm The duty cycle at that temperature (in %)
+ *
+ * @return FourWireFanCurve*
+ */
+FourWireFanCurve* FourWireFanCurve::add(int16_t temperature, uint8_t pwm)
+{
+    if ((this->size < FOURWIREFAN_CURVE_POINTS) && ((0 == this->size) || (temperature > this->temperature[this->size - 1]))) {
+        this->temperature[this->size] = temperature;
+        this->pwm[this->size] = min(pwm, (uint8_t) 100);
+        this->size++;
+    }
+
+    return this;
+}
+
+/**
+ * Returns the duty cycle at a temperature, interpolated between the neighbouring points.
+ *
+ * @since 2026-10-16
+ *
+ * @param temperature The temperature (in 1/10 °C)
+ *
+ * @return uint16_t The duty cycle (in 1/65535, full duty without any points)
+ */
+uint16_t FourWireFanCurve::toDuty(int16_t temperature)
+{
+    if (0 == this->size) {
+        return 0xFFFF;
+    }
+
+    if (temperature <= this->temperature[0]) {
+        return FourWireFan::toDuty(this->pwm[0]);
+    }
+
+    uint8_t i = 1;
+
+    while ((i < this->size) && (temperature > this->temperature[i])) {
+        i++;
+    }
+
+    if (i == this->size) {
+        return FourWireFan::toDuty(this->pwm[i - 1]);
+    }
+
+    uint16_t lo = FourWireFan::toDuty(this->pwm[i - 1]);
+    uint16_t hi = FourWireFan::toDuty(this->pwm[i]);
+    uint16_t span = this->temperature[i] - this->temperature[i - 1];   // ascending, so this fits
+    uint16_t x = temperature - this->temperature[i - 1];               // 0 < x <= span
+
+    if (hi >= lo) {
+        return lo + (uint32_t) (hi - lo) * x / span;                    // at most 65535², i.e. no overflow
+    }
+
+    return lo - (uint32_t) (lo - hi) * x / span;
+}
+
+/**
+ * Constructs a new thermal engine.
+ *
+ * @since 2026-10-16
+ *
+ * @param combination The combination of a fan's duty cycles (see `FourWireFanCombination`)
+ * @param rise The maximum duty cycle increase (in % per second, 0: none)
+ * @param fall The maximum duty cycle decrease (in % per second, 0: none)
+ */
+FourWireFanThermal::FourWireFanThermal(uint8_t combination, uint8_t rise, uint8_t fall) :
+    _combination(combination),
+    _rise(rise),
+    _fall(fall)
+{
+    /* nop */
+}
+
+/**
+ * Adds a temperature zone.
+ *
+ * @since 2026-10-16
+ *
+ * @param sensor The sensor callback, returning the temperature (in 1/10 °C, or `FOURWIREFAN_NO_TEMPERATURE` on failure)
+ *
+ * @return int8_t The zone index (or -1 if there's no room for another zone)
+ */
+int8_t FourWireFanThermal::addZone(int16_t (*sensor)(void))
+{
+    if (this->_zoneCount >= FOURWIREFAN_ZONES) {
+        return -1;
+    }
+
+    this->_zones[this->_zoneCount].sensor = sensor;
+    this->_zones[this->_zoneCount].temperature = FOURWIREFAN_NO_TEMPERATURE;
+
+    return this->_zoneCount++;
+}
+
+/**
+ * Drives a fan from a zone via a curve.
+ *
+ * A fan may be driven from several zones (each with its own curve), and a zone may drive several fans.
+ *
+ * @since 2026-10-16
+ *
+ * @param zone The zone index (see `addZone()`)
+ * @param fan The fan to drive
+ * @param curve The fan curve (shared curves are fine)
+ * @param weight The weight within a weighted mean (see `FOURWIREFAN_WEIGHTED`)
+ * @param hysteresis The temperature drop required before the duty cycle is lowered (in 1/10 °C)
+ *
+ * @return bool Whether the binding has been added (or there's no room for another one)
+ */
+bool FourWireFanThermal::bind(uint8_t zone, FourWireFan* fan, FourWireFanCurve* curve, uint8_t weight, uint8_t hysteresis)
+{
+    uint8_t index = 0;
+
+    while ((index < this->_fanCount) && (fan != this->_fans[index])) {
+        index++;
+    }
+
+    if ((zone >= this->_zoneCount) || (this->_bindingCount >= FOURWIREFAN_BINDINGS) || (index >= FOURWIREFAN_THERMAL_FANS)) {
+        return false;
+    }
+
+    if (index == this->_fanCount) {
+        this->_fans[this->_fanCount++] = fan;       // a fan not driven yet…
+        fan->setSlewRate(this->_rise, this->_fall); // …is rate limited from now on
+    }
+
+    Binding* binding = &this->_bindings[this->_bindingCount++];
+
+    binding->curve = curve;
+    binding->zone = zone;
+    binding->fan = index;
+    binding->weight = weight;
+    binding->hysteresis = hysteresis;
+    binding->reference = FOURWIREFAN_NO_TEMPERATURE;
+
+    return true;
+}
+
+/**
+ * Reads all sensors and updates all fans.
+ *
+ * This should be called once per tick, e.g. along with the fans' `update()` (which apply the duty cycles at their slew rate).
+ *
+ * @since 2026-10-16
+ */
+void FourWireFanThermal::update()
+{
+    uint16_t highest[FOURWIREFAN_THERMAL_FANS] = {0}; // the highest duty cycle per fan (in 1/65535)
+    uint32_t sum[FOURWIREFAN_THERMAL_FANS] = {0};   // the weighted sum of duty cycles per fan
+    uint16_t weights[FOURWIREFAN_THERMAL_FANS] = {0}; // the sum of weights per fan
+    bool failed[FOURWIREFAN_THERMAL_FANS] = {false}; // a bound sensor has failed (per fan)
+
+    /* sensors, once each */
+    for (uint8_t i = 0; i < this->_zoneCount; i++) {
+        this->_zones[i].temperature = this->_zones[i].sensor();
+    }
+
+    /* curves (with hysteresis) */
+    for (uint8_t i = 0; i < this->_bindingCount; i++) {
+        Binding* binding = &this->_bindings[i];
+        int16_t temperature = this->_zones[binding->zone].temperature;
+        uint16_t duty = 0xFFFF;                     // failed sensor: full duty (as a safety measure!)
+
+        failed[binding->fan] = failed[binding->fan] || (FOURWIREFAN_NO_TEMPERATURE == temperature);
+
+        if (FOURWIREFAN_NO_TEMPERATURE != temperature) {
+            if ((FOURWIREFAN_NO_TEMPERATURE == binding->reference) || (temperature > binding->reference)) {
+                binding->reference = temperature;   // rising: follow right away
+            } else if ((int32_t) temperature < (int32_t) binding->reference - binding->hysteresis) {
+                binding->reference = temperature + binding->hysteresis; // falling: follow at a distance
+            }
+
+            duty = binding->curve->toDuty(binding->reference);
+        }
+
+        highest[binding->fan] = max(highest[binding->fan], duty);
+        sum[binding->fan] += (uint32_t) duty * binding->weight;
+        weights[binding->fan] += binding->weight;
+    }
+
+    /* fans, once each */
+    for (uint8_t i = 0; i < this->_fanCount; i++) {
+        uint16_t target = highest[i];
+
+        if ((FOURWIREFAN_WEIGHTED == this->_combination) && weights[i] && !failed[i]) {
+            target = (sum[i] + weights[i] / 2) / weights[i]; // (not averaging a failed sensor's full duty away)
+        }
+
+        this->_fans[i]->setDuty(target);            // (rate limited by the fan)
+    }
+}
+
+/**
+ * Returns a zone's most recent temperature.
+ *
+ * @since 2026-10-16
+ *
+ * @param zone The zone index
+ *
+ * @return int16_t The temperature (in 1/10 °C, or `FOURWIREFAN_NO_TEMPERATURE`)
+ */
+int16_t FourWireFanThermal::getTemperature(uint8_t zone)
+{
+    return (zone < this->_zoneCount) ? this->_zones[zone].temperature : FOURWIREFAN_NO_TEMPERATURE;
+}
+
+/**
+ * Updates the rate limits, i.e. the slew rate of all driven fans (see `FourWireFan::setSlewRate()`).
+ *
+ * @since 2026-10-16
+ *
+ * @param rise The maximum duty cycle increase (in % per second, 0: none)
+ * @param fall The maximum duty cycle decrease (in % per second, 0: none)
+ *
+ * @return FourWireFanThermal*
+ */
+FourWireFanThermal* FourWireFanThermal::setRate(uint8_t rise, uint8_t fall)
+{
+    this->_rise = rise;
+    this->_fall = fall;
+
+    for (uint8_t i = 0; i < this->_fanCount; i++) {
+        this->_fans[i]->setSlewRate(rise, fall);
+    }
+
+    return this;
+}
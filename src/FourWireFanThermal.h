@@ -0,0 +1,123 @@
+/**
+ * Four Wire Fan
+ *
+ * An Arduino four-wire fan library that provides a PWM speed and tachometer interface.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FourWireFan)
+ * @date 22.07.2020 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef __FOURWIREFANTHERMAL_H__
+#define __FOURWIREFANTHERMAL_H__
+
+#include "FourWireFan.h"
+
+#ifndef FOURWIREFAN_CURVE_POINTS
+#define FOURWIREFAN_CURVE_POINTS 6                      // maximum number of points per curve
+#endif
+
+#ifndef FOURWIREFAN_ZONES
+#define FOURWIREFAN_ZONES 4                             // maximum number of temperature zones (i.e. sensors)
+#endif
+
+#ifndef FOURWIREFAN_THERMAL_FANS
+#define FOURWIREFAN_THERMAL_FANS 4                      // maximum number of fans driven by a thermal engine
+#endif
+
+#ifndef FOURWIREFAN_BINDINGS
+#define FOURWIREFAN_BINDINGS 8                          // maximum number of zone-to-fan curves
+#endif
+
+#define FOURWIREFAN_NO_TEMPERATURE INT16_MIN            // sensor reading: no (valid) temperature available
+
+/**
+ * Combinations of the duty cycles a fan's curves ask for.
+ */
+enum FourWireFanCombination : uint8_t {
+    FOURWIREFAN_MAX = 0,       // the highest duty cycle wins (default)
+    FOURWIREFAN_WEIGHTED = 1   // the weighted mean of all duty cycles
+};
+
+/**
+ * A piecewise linear fan curve, i.e. duty cycles at ascending temperatures (in 1/10 °C).
+ *
+ * Below the first point, its duty cycle applies, likewise above the last one. A curve holds no state,
+ * so it can be shared between fans and zones.
+ */
+class FourWireFanCurve {
+    public:
+        // public properties to avoid the getter/setter pattern
+        int16_t temperature[FOURWIREFAN_CURVE_POINTS];  // the temperatures (in 1/10 °C, ascending)
+        uint8_t pwm[FOURWIREFAN_CURVE_POINTS];          // the duty cycles at these temperatures (in %)
+        uint8_t size = 0;                               // the number of points
+
+        FourWireFanCurve* add(int16_t temperature, uint8_t pwm); // Appends a point (at a higher temperature than the previous one)
+        uint16_t toDuty(int16_t temperature);           // Returns the duty cycle at a temperature (in 1/65535)
+};
+
+/**
+ * A thermal engine that drives fans from temperature zones via fan curves.
+ *
+ * Each zone has a sensor callback returning its temperature (in 1/10 °C, or `FOURWIREFAN_NO_TEMPERATURE` on failure).
+ * Each binding maps one zone to one fan via a curve, with its own hysteresis: a falling temperature lowers the duty cycle
+ * only once it has fallen by more than the hysteresis. A failed sensor gets its fans full duty (as a safety measure), whatever the combination.
+ * Per fan, the duty cycles of all its bindings are combined (maximum or weighted mean). The rate limits are the fan's own,
+ * i.e. its slew rate (see `FourWireFan::setSlewRate()`), which is set when the fan is bound (and by `setRate()`).
+ *
+ * Each `update()` reads every sensor exactly once and sets each fan's duty cycle exactly once (integer math only).
+ * The fan's own limits still apply (see `FourWireFan::setDuty()`), and so does its spin-up handling.
+ */
+class FourWireFanThermal {
+    public:
+        /**
+         * Constructs a new thermal engine.
+         *
+         * @param combination The combination of a fan's duty cycles (default: maximum)
+         * @param rise        The maximum duty cycle increase (default: 100% per second)
+         * @param fall        The maximum duty cycle decrease (default: 10% per second)
+         */
+        FourWireFanThermal(uint8_t combination = FOURWIREFAN_MAX, uint8_t rise = 100, uint8_t fall = 10);
+
+        int8_t addZone(int16_t (*sensor)(void));                    // Adds a temperature zone, returns its index (or -1 if full)
+        bool bind(uint8_t zone, FourWireFan* fan, FourWireFanCurve* curve, uint8_t weight = 1, uint8_t hysteresis = 20); // Drives a fan from a zone via a curve
+
+        void update();                                              // Reads all sensors and updates all fans (call once per tick)
+
+        int16_t getTemperature(uint8_t zone);                       // Returns a zone's most recent temperature (in 1/10 °C)
+        FourWireFanThermal* setRate(uint8_t rise, uint8_t fall);    // Updates the rate limits of all driven fans (in % per second, 0: none)
+
+    protected:
+        /**
+         * A temperature zone.
+         */
+        struct Zone {
+            int16_t (*sensor)(void);                                // the sensor callback
+            int16_t temperature;                                    // the most recent temperature (in 1/10 °C)
+        };
+
+        /**
+         * A curve from a zone to a fan.
+         */
+        struct Binding {
+            FourWireFanCurve* curve;                                // the fan curve
+            uint8_t zone;                                           // the zone index
+            uint8_t fan;                                            // the fan index
+            uint8_t weight;                                         // the weight within a weighted mean
+            uint8_t hysteresis;                                     // the hysteresis (in 1/10 °C)
+            int16_t reference;                                      // the temperature the curve is evaluated at (in 1/10 °C)
+        };
+
+        uint8_t _combination;                                       // the combination of a fan's duty cycles
+        uint8_t _rise;                                              // the maximum duty cycle increase (in % per second)
+        uint8_t _fall;                                              // the maximum duty cycle decrease (in % per second)
+
+        Zone _zones[FOURWIREFAN_ZONES];                             // the temperature zones
+        FourWireFan* _fans[FOURWIREFAN_THERMAL_FANS];               // the driven fans
+        Binding _bindings[FOURWIREFAN_BINDINGS];                    // the curves from zones to fans
+        uint8_t _zoneCount = 0;                                     // the number of zones
+        uint8_t _fanCount = 0;                                      // the number of driven fans
+        uint8_t _bindingCount = 0;                                  // the number of bindings
+};
+
+#endif  // __FOURWIREFANTHERMAL_H__